@@ -0,0 +1,58 @@
+#ifndef CondFormats_EcalObjects_EcalAlignedAllocator_H
+#define CondFormats_EcalObjects_EcalAlignedAllocator_H
+/**
+ * Allocator returning storage aligned to Alignment bytes (one cache
+ * line by default), so that std::vector based per-crystal arrays can
+ * be streamed with aligned vector loads.
+ *
+ * Transient helper: not to be used in persistent classes.
+ **/
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+template <typename T, size_t Alignment = 64>
+class EcalAlignedAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind { typedef EcalAlignedAllocator<U, Alignment> other; };
+
+  static const size_t alignment = Alignment;
+
+  EcalAlignedAllocator() {}
+  EcalAlignedAllocator(const EcalAlignedAllocator&) {}
+  template <typename U>
+  EcalAlignedAllocator(const EcalAlignedAllocator<U, Alignment>&) {}
+  ~EcalAlignedAllocator() {}
+
+  pointer address(reference x) const { return &x; }
+  const_pointer address(const_reference x) const { return &x; }
+
+  pointer allocate(size_type n, const void* = 0) {
+    if (n == 0) return 0;
+    void* p = 0;
+    if (posix_memalign(&p, Alignment, n * sizeof(T)) != 0) throw std::bad_alloc();
+    return static_cast<pointer>(p);
+  }
+
+  void deallocate(pointer p, size_type) { free(p); }
+
+  size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+  void construct(pointer p, const T& val) { new (static_cast<void*>(p)) T(val); }
+  void destroy(pointer p) { p->~T(); }
+
+  bool operator==(const EcalAlignedAllocator&) const { return true; }
+  bool operator!=(const EcalAlignedAllocator&) const { return false; }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef CondFormats_EcalObjects_EcalCalibrationSnapshot_H
+#define CondFormats_EcalObjects_EcalCalibrationSnapshot_H
+/**
+ * Per-crystal calibration snapshot combining the conditions used by the
+ * rechit calibration into a single array indexed by the ECAL dense index
+ * (see EcalDenseIndex):
+ *
+ *   scale      = intercalib * ADCToGeV(EB|EE) * laser correction
+ *   timeOffset = time calib + time offset(EB|EE)
+ *
+ * The laser correction is computed by EcalLaserCorrectionEngine at the
+ * laser evaluation time; the laser region (0..91, index in the time map of
+ * EcalLaserAPDPNRatios) of each crystal is given by the user, as the crystal
+ * to region mapping lives outside of this package.
+ *
+ * update() rebuilds the snapshot only when the cache identifier of one of
+ * the inputs (typically the EventSetup record cacheIdentifier()) or the
+ * laser evaluation time changed. Every input except the intercalibration
+ * is optional. A null ADCToGeV, time calibration or time offset counts as
+ * 1 or 0; a null APD/PN ratio payload skips the laser correction. Within
+ * the laser correction a null reference counts as 1 and null alphas as
+ * alpha = 1, which still applies the APD/PN ratio (to the first power):
+ * it is not neutral.
+ *
+ * Transient object, not stored in the database. update() is not thread
+ * safe: share the snapshot read-only once built.
+ **/
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalAlignedAllocator.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+#include "CondFormats/EcalObjects/interface/EcalIntercalibConstants.h"
+#include "CondFormats/EcalObjects/interface/EcalLaserCorrectionEngine.h"
+#include "CondFormats/EcalObjects/interface/EcalADCToGeVConstant.h"
+#include "CondFormats/EcalObjects/interface/EcalTimeCalibConstants.h"
+#include "CondFormats/EcalObjects/interface/EcalTimeOffsetConstant.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+
+class EcalCalibrationSnapshot {
+ public:
+  struct Constants {
+    float scale;
+    float timeOffset;
+  };
+  typedef std::vector<Constants, EcalAlignedAllocator<Constants> > ConstantsVector;
+
+  /// input payloads, each with the cache identifier of its IOV
+  struct Inputs {
+    Inputs();
+    const EcalIntercalibConstants* intercalib;        unsigned long long intercalibId;
+    const EcalADCToGeVConstant* adcToGeV;             unsigned long long adcToGeVId;
+    const EcalLaserAPDPNRatios* apdpn;                unsigned long long apdpnId;
+    const EcalLaserAPDPNRatiosRef* apdpnRef;          unsigned long long apdpnRefId;
+    const EcalLaserAlphas* alphas;                    unsigned long long alphasId;
+    const EcalTimeCalibConstants* timeCalib;          unsigned long long timeCalibId;
+    const EcalTimeOffsetConstant* timeOffset;         unsigned long long timeOffsetId;
+    /// laser region of each crystal, by dense index; needed only if apdpn is given
+    const std::vector<uint8_t>* laserRegions;
+    /// time at which the laser correction is evaluated
+    edm::Timestamp laserTime;
+  };
+
+  EcalCalibrationSnapshot();
+  ~EcalCalibrationSnapshot();
+
+  /// rebuild if any input changed since the last call, returns true if rebuilt
+  bool update(const Inputs& inputs);
+
+  /// force a rebuild at the next update()
+  void invalidate() { valid_ = false; }
+
+  const Constants& operator[](uint32_t rawId) const { return constants_[EcalDenseIndex::fromRawId(rawId)]; }
+  const Constants& item(size_t denseIndex) const { return constants_[denseIndex]; }
+
+  /// kSizeForDenseIndexing elements, plus a trailing neutral element returned for invalid ids
+  const ConstantsVector& constants() const { return constants_; }
+
+  size_t size() const { return EcalDenseIndex::kSizeForDenseIndexing; }
+
+ private:
+  EcalCalibrationSnapshot(const EcalCalibrationSnapshot&);             // not copyable
+  EcalCalibrationSnapshot& operator=(const EcalCalibrationSnapshot&);
+
+  bool sameKeys(const Inputs& inputs) const;
+  bool sameLaserKeys(const Inputs& inputs) const;
+  void build(const Inputs& inputs);
+
+  ConstantsVector constants_;
+  EcalLaserCorrectionEngine* laserEngine_;  // owned, null without APD/PN ratios
+  std::vector<float> laser_;
+  Inputs keys_;
+  bool valid_;
+};
+
+#endif
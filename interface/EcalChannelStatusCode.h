@@ -39,6 +39,11 @@ class EcalChannelStatusCode {
     static const int chStatusMask      = 0x1F;
     static const int HVbitMask         = 0x1<<5;
     static const int LVbitMask         = 0x1<<6;
+    static const int DAQbitMask        = 0x1<<7;
+    static const int TPbitMask         = 0x1<<8;
+    static const int TriggerbitMask    = 0x1<<9;
+    static const int TemperaturebitMask = 0x1<<10;
+    static const int DeadNeighbourbitMask = 0x1<<11;
 
   private:
     /* bits 1-5 store a status code:
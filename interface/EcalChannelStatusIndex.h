@@ -0,0 +1,56 @@
+#ifndef CondFormats_EcalObjects_EcalChannelStatusIndex_H
+#define CondFormats_EcalObjects_EcalChannelStatusIndex_H
+/**
+ * Bitset index of an EcalChannelStatus payload.
+ *
+ * Built once per IOV, it holds one EcalDenseBitset per value of the decoded
+ * status code (0 to chStatusMask) and one per flag bit of
+ * EcalChannelStatusCode (HV, LV, DAQ, TP, trigger, temperature, dead
+ * neighbour), so that questions on the whole detector become a few word
+ * operations instead of a decoding loop over all the crystals:
+ *
+ *   EcalChannelStatusIndex index(channelStatus);
+ *   EcalDenseBitset dead = index.statusRange(10, 12);     // dead of any type
+ *   dead.andNot(index.flag(EcalChannelStatusIndex::HV)); // ... with HV bit not set
+ *   for (uint32_t i : dead) ...
+ *
+ * Crystals missing from the payload count as status 0, as for operator[].
+ *
+ * Transient object.
+ **/
+
+#include "CondFormats/EcalObjects/interface/EcalChannelStatus.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseBitset.h"
+
+class EcalChannelStatusIndex {
+ public:
+  enum Flag { HV = 0, LV, DAQ, TP, Trigger, Temperature, DeadNeighbour, kNFlags };
+
+  static const int kNStatus = EcalChannelStatusCode::chStatusMask + 1;
+
+  explicit EcalChannelStatusIndex(const EcalChannelStatus& status);
+
+  /// crystals with the given decoded status
+  const EcalDenseBitset& status(int code) const { return status_[code & EcalChannelStatusCode::chStatusMask]; }
+
+  /// crystals with decoded status in [lo, hi]
+  EcalDenseBitset statusRange(int lo, int hi) const;
+
+  /// crystals with the flag bit set
+  const EcalDenseBitset& flag(Flag f) const { return flags_[f]; }
+
+  /// crystals with any of the bits of mask (EcalChannelStatusCode::HVbitMask, ...) set
+  EcalDenseBitset flags(int mask) const;
+
+  /// number of crystals with the given decoded status
+  uint32_t count(int code) const { return status(code).count(); }
+
+  /// bit of the status word of a flag
+  static int bitMask(Flag f);
+
+ private:
+  EcalDenseBitset status_[kNStatus];
+  EcalDenseBitset flags_[kNFlags];
+};
+
+#endif
@@ -4,6 +4,9 @@
 #include "DataFormats/EcalDetId/interface/EcalContainer.h"
 #include "DataFormats/EcalDetId/interface/EBDetId.h"
 #include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+
+#include <algorithm>
 
 template < typename T >
 class EcalCondObjectContainer {
@@ -15,6 +18,9 @@ class EcalCondObjectContainer {
                 typedef typename std::vector<Item>::const_iterator const_iterator; 
                 typedef typename std::vector<Item>::iterator iterator;
 
+                /// EB crystals first (EBDetId::denseIndex), then EE crystals (EEDetId::denseIndex + EB size)
+                static const size_t kSizeForDenseIndexing = EcalDenseIndex::kSizeForDenseIndexing;
+
                 EcalCondObjectContainer() {};
                 ~EcalCondObjectContainer() {};
 
@@ -56,26 +62,31 @@ class EcalCondObjectContainer {
                 
                 inline
                 const_iterator find( uint32_t rawId ) const {
-                        DetId id(rawId);
-                        switch (id.subdetId()) {
-                                case EcalBarrel :
-                                        { 
-                                                const_iterator it = eb_.find(rawId);
-                                                if ( it != eb_.end() ) {
-                                                        return it;
-                                                } else {
-                                                        return ee_.end();
-                                                }
-                                        }
-                                        break;
-                                case EcalEndcap :
-                                        { 
-                                                return ee_.find(rawId);
-                                        }
-                                        break;
-                                default:
-                                        // FIXME (add throw)
-                                        return ee_.end();
+                        const size_t i = EcalDenseIndex::fromRawId(rawId);
+                        if ( i < EcalDenseIndex::kEBSize ) {
+                                return i < eb_.items().size() ? eb_.begin() + i : ee_.end();
+                        }
+                        const size_t j = i - EcalDenseIndex::kEBSize;
+                        return j < ee_.items().size() ? ee_.begin() + j : ee_.end();
+                }
+
+                /// dense index of rawId, kSizeForDenseIndexing if rawId is not an ECAL crystal
+                static inline
+                size_t denseIndex( uint32_t rawId ) {
+                        return EcalDenseIndex::fromRawId(rawId);
+                }
+
+                /// item by dense index, a default item for denseIndex >= kSizeForDenseIndexing or an empty half
+                inline
+                const Item & item( size_t denseIndex ) const {
+                        return *itemPointer(denseIndex);
+                }
+
+                /// out[i] = (*this)[rawIds[i]] for i < n, without branching on the subdetector
+                inline
+                void gather( const uint32_t * rawIds, size_t n, Item * out ) const {
+                        for (size_t i = 0; i < n; ++i) {
+                                out[i] = *itemPointer(EcalDenseIndex::fromRawId(rawIds[i]));
                         }
                 }
 
@@ -94,6 +105,28 @@ class EcalCondObjectContainer {
                         (*this)[id] = item;
                 }
 
+                /// set the items of dense indices 0 to n - 1 (see EcalDenseIndex) from an array in dense index order;
+                /// n is capped to kSizeForDenseIndexing, the other items are left unchanged
+                inline
+                void fill( const Item * denseItems, size_t n ) {
+                        if ( n > kSizeForDenseIndexing ) n = kSizeForDenseIndexing;
+                        const size_t nEB = std::min( n, size_t(EcalDenseIndex::kEBSize) );
+                        if ( nEB > 0 ) std::copy( denseItems, denseItems + nEB, halfItems( eb_, EcalDenseIndex::kEBSize, 0 ) );
+                        if ( n > nEB ) {
+                                std::copy( denseItems + nEB, denseItems + n,
+                                           halfItems( ee_, EcalDenseIndex::kEESize, EcalDenseIndex::kEBSize ) );
+                        }
+                }
+
+                /// set all the items at once, item i being f(i) for each dense index i, in increasing order
+                template < typename F >
+                void generate( F f ) {
+                        Item * eb = halfItems( eb_, EcalDenseIndex::kEBSize, 0 );
+                        for ( size_t i = 0; i < EcalDenseIndex::kEBSize; ++i ) eb[i] = f(i);
+                        Item * ee = halfItems( ee_, EcalDenseIndex::kEESize, EcalDenseIndex::kEBSize );
+                        for ( size_t i = 0; i < EcalDenseIndex::kEESize; ++i ) ee[i] = f(EcalDenseIndex::kEBSize + i);
+                }
+
                 inline
                 const self & getMap() const {
                         return *this;
@@ -128,29 +161,47 @@ class EcalCondObjectContainer {
                 
                 inline
                 Item const & operator[]( uint32_t rawId ) const {
-                        DetId id(rawId);
-                        static Item dummy;
-                        switch (id.subdetId()) {
-                                case EcalBarrel :
-                                        { 
-                                                return eb_[rawId];
-                                        }
-                                        break;
-                                case EcalEndcap :
-                                        { 
-                                                return ee_[rawId];
-                                        }
-                                        break;
-                                default:
-                                        // FIXME (add throw)
-                                        return dummy;
-                        }
+                        return *itemPointer(EcalDenseIndex::fromRawId(rawId));
                 }
                 
         private:
+                // barrel and endcap vectors are addressed as one array of
+                // kSizeForDenseIndexing items; out of range indices, and indices
+                // in a half which is empty (as read from some payloads), give dummy_
+                inline
+                const Item * itemPointer( size_t denseIndex ) const {
+                        const bool isEE = denseIndex >= EcalDenseIndex::kEBSize;
+                        const size_t offset = isEE ? denseIndex - EcalDenseIndex::kEBSize : denseIndex;
+                        const Items & half = isEE ? ee_.items() : eb_.items();
+                        return offset < half.size() ? &half[0] + offset : &dummy_;
+                }
+
+                // the items of one half, its first crystal having dense index first, as one
+                // writable array of n items: the half is sized to n items if it is empty, or
+                // rebuilt with its items kept if it is shorter (as read from some payloads)
+                template < typename C >
+                static Item * halfItems( C & half, size_t n, uint32_t first ) {
+                        half.checkAndResize( n );
+                        if ( half.size() < n ) {
+                                C full;
+                                full.checkAndResize( n );
+                                std::copy( half.begin(), half.end(), &full[EcalDenseIndex::toRawId(first)] );
+                                half = full;
+                        }
+                        return &half[EcalDenseIndex::toRawId(first)];
+                }
+
+                static const Item dummy_;
+
                 EcalContainer< EBDetId, Item > eb_;
                 EcalContainer< EEDetId, Item > ee_;
 };
 
+template < typename T >
+const size_t EcalCondObjectContainer<T>::kSizeForDenseIndexing;
+
+template < typename T >
+const T EcalCondObjectContainer<T>::dummy_ = T();
+
 typedef EcalCondObjectContainer<float> EcalFloatCondObjectContainer;
 #endif
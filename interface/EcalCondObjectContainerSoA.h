@@ -0,0 +1,222 @@
+#ifndef CondFormats_EcalObjects_EcalCondObjectContainerSoA_H
+#define CondFormats_EcalObjects_EcalCondObjectContainerSoA_H
+/**
+ * Structure-of-arrays twin of EcalCondObjectContainer.
+ *
+ * Each field of the item type is stored in its own contiguous, cache line
+ * aligned column running over the whole ECAL in dense index order
+ * (EB denseIndex first, then EE denseIndex + EBDetId::kSizeForDenseIndexing).
+ * A loop which only needs e.g. EcalPedestal::mean_x12 then streams a single
+ * float column instead of the full structs.
+ *
+ * How an item is split into columns is decided by the Layout policy. The
+ * default, EcalSoAFieldLayout<T, F>, handles the common case of a plain
+ * struct made of consecutive fields of the same type F, the same
+ * assumption EcalPedestal::mean_rms() already makes. F is float by default
+ * (EcalPedestal, EcalLaserAPDPNpair, float, ...); structs of integers need
+ * their own field type, e.g. for EcalTPGLinearizationConstant:
+ *
+ *   EcalCondObjectContainerSoA<EcalTPGLinearizationConstant,
+ *                              EcalSoAFieldLayout<EcalTPGLinearizationConstant, uint32_t> > lin(linConst);
+ *
+ * sizeof(T) must be a multiple of sizeof(F), checked at compile time.
+ *
+ * The usual operator[]/find/barrelItems()/endcapItems() interface is kept
+ * through proxies which gather (or scatter) the item on access:
+ *
+ *   EcalCondObjectContainerSoA<EcalPedestal> peds(pedestals);
+ *   EcalPedestal p = peds[rawId];                   // gathers all fields
+ *   const float * m12 = peds.column(0);              // mean_x12 of all crystals
+ *
+ * Transient object: it is built from (and can be converted back to) the
+ * persistent EcalCondObjectContainer, it is not stored in the database.
+ **/
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <boost/static_assert.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalCondObjectContainer.h"
+#include "CondFormats/EcalObjects/interface/EcalAlignedAllocator.h"
+
+/// Layout policy for items made of sizeof(T)/sizeof(F) consecutive fields of type F
+template <typename T, typename F>
+struct EcalSoAFieldLayout {
+  typedef F Field;
+  BOOST_STATIC_ASSERT(sizeof(T) >= sizeof(F) && sizeof(T) % sizeof(F) == 0);
+  static const size_t nFields = sizeof(T) / sizeof(F);
+
+  static Field get(const T& item, size_t k) {
+    return reinterpret_cast<const Field*>(&item)[k];
+  }
+
+  static void set(T& item, size_t k, Field value) {
+    reinterpret_cast<Field*>(&item)[k] = value;
+  }
+};
+
+template <typename T, typename Layout = EcalSoAFieldLayout<T, float> >
+class EcalCondObjectContainerSoA {
+ public:
+  typedef T Item;
+  typedef Item value_type;
+  typedef Layout layout_type;
+  typedef typename Layout::Field Field;
+  typedef EcalCondObjectContainerSoA<T, Layout> self;
+  typedef std::vector<Field, EcalAlignedAllocator<Field> > Columns;
+
+  static const size_t nFields = Layout::nFields;
+  static const size_t kEBSize = EcalDenseIndex::kEBSize;
+  static const size_t kEESize = EcalDenseIndex::kEESize;
+  static const size_t kSize = EcalDenseIndex::kSizeForDenseIndexing;
+
+  /// read-only proxy on one crystal
+  class const_reference {
+   public:
+    const_reference(const self* c, size_t i) : c_(c), i_(i) {}
+    operator Item() const { return c_->get(i_); }
+    /// k-th field, only for proxies on valid crystals
+    Field field(size_t k) const { return c_->column(k)[i_]; }
+    size_t denseIndex() const { return i_; }
+   protected:
+    const self* c_;
+    size_t i_;
+  };
+
+  /// read-write proxy on one crystal, assignment scatters the item on the columns
+  class reference : public const_reference {
+   public:
+    reference(self* c, size_t i) : const_reference(c, i) {}
+    reference& operator=(const Item& item) {
+      const_cast<self*>(this->c_)->set(this->i_, item);
+      return *this;
+    }
+    reference& operator=(const reference& other) { return (*this) = Item(other); }
+    void setField(size_t k, Field value) { const_cast<self*>(this->c_)->column(k)[this->i_] = value; }
+  };
+
+  /// random access iterator over crystals in dense index order
+  class const_iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef Item value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef const_reference reference;
+
+    const_iterator() : c_(0), i_(0) {}
+    const_iterator(const self* c, size_t i) : c_(c), i_(i) {}
+    const_reference operator*() const { return const_reference(c_, i_); }
+    const_reference operator[](ptrdiff_t n) const { return const_reference(c_, i_ + n); }
+    const_iterator& operator++() { ++i_; return *this; }
+    const_iterator operator++(int) { const_iterator t(*this); ++i_; return t; }
+    const_iterator& operator--() { --i_; return *this; }
+    const_iterator operator--(int) { const_iterator t(*this); --i_; return t; }
+    const_iterator& operator+=(ptrdiff_t n) { i_ += n; return *this; }
+    const_iterator& operator-=(ptrdiff_t n) { i_ -= n; return *this; }
+    const_iterator operator+(ptrdiff_t n) const { return const_iterator(c_, i_ + n); }
+    const_iterator operator-(ptrdiff_t n) const { return const_iterator(c_, i_ - n); }
+    ptrdiff_t operator-(const const_iterator& o) const { return ptrdiff_t(i_) - ptrdiff_t(o.i_); }
+    bool operator==(const const_iterator& o) const { return i_ == o.i_; }
+    bool operator!=(const const_iterator& o) const { return i_ != o.i_; }
+    bool operator<(const const_iterator& o) const { return i_ < o.i_; }
+    size_t denseIndex() const { return i_; }
+   private:
+    const self* c_;
+    size_t i_;
+  };
+
+  /// view on the barrel or endcap part, replaces the Items vectors of the AoS container
+  class Items {
+   public:
+    Items(const self* c, size_t first, size_t n) : c_(c), first_(first), n_(n) {}
+    size_t size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+    const_reference operator[](size_t i) const { return const_reference(c_, first_ + i); }
+    const_iterator begin() const { return const_iterator(c_, first_); }
+    const_iterator end() const { return const_iterator(c_, first_ + n_); }
+    /// pointer to the k-th field of the first crystal of the view
+    const Field* column(size_t k) const { return c_->column(k) + first_; }
+   private:
+    const self* c_;
+    size_t first_;
+    size_t n_;
+  };
+
+  EcalCondObjectContainerSoA() : stride_(paddedSize()), data_(nFields * paddedSize(), Field()) {}
+
+  explicit EcalCondObjectContainerSoA(const EcalCondObjectContainer<T>& aos)
+    : stride_(paddedSize()), data_(nFields * paddedSize(), Field()) {
+    const typename EcalCondObjectContainer<T>::Items& eb = aos.barrelItems();
+    for (size_t i = 0; i < eb.size() && i < kEBSize; ++i) set(i, eb[i]);
+    const typename EcalCondObjectContainer<T>::Items& ee = aos.endcapItems();
+    for (size_t i = 0; i < ee.size() && i < kEESize; ++i) set(kEBSize + i, ee[i]);
+  }
+
+  /// convert back to the persistent array-of-structs container
+  EcalCondObjectContainer<T> toAoS() const {
+    EcalCondObjectContainer<T> aos;
+    for (size_t i = 0; i < kSize; ++i) aos.setValue(EcalDenseIndex::toRawId(i), get(i));
+    return aos;
+  }
+
+  /// contiguous, aligned array with the k-th field of all the crystals
+  inline const Field* column(size_t k) const { return &data_[k * stride_]; }
+  inline Field* column(size_t k) { return &data_[k * stride_]; }
+
+  inline Items barrelItems() const { return Items(this, 0, kEBSize); }
+  inline Items endcapItems() const { return Items(this, kEBSize, kEESize); }
+
+  inline const_reference barrel(size_t hashedIndex) const { return const_reference(this, hashedIndex); }
+  inline const_reference endcap(size_t hashedIndex) const { return const_reference(this, kEBSize + hashedIndex); }
+
+  inline const_reference item(size_t denseIndex) const { return const_reference(this, denseIndex); }
+
+  inline const_iterator begin() const { return const_iterator(this, 0); }
+  inline const_iterator end() const { return const_iterator(this, kSize); }
+
+  inline const_iterator find(uint32_t rawId) const { return const_iterator(this, denseIndex(rawId)); }
+
+  inline size_t size() const { return kSize; }
+
+  inline void insert(std::pair<uint32_t, Item> const& a) { setValue(a.first, a.second); }
+
+  inline void setValue(const uint32_t id, const Item& item) {
+    size_t i = denseIndex(id);
+    if (i < kSize) set(i, item);
+  }
+
+  /// for an invalid rawId the returned proxy converts to a default constructed Item
+  inline const_reference operator[](uint32_t rawId) const { return const_reference(this, denseIndex(rawId)); }
+  inline reference operator[](uint32_t rawId) { return reference(this, denseIndex(rawId)); }
+
+  inline const self& getMap() const { return *this; }
+
+  /// dense index of rawId, size() if rawId is not an ECAL crystal
+  static size_t denseIndex(uint32_t rawId) { return EcalDenseIndex::fromRawId(rawId); }
+
+ private:
+  // columns are padded to a multiple of the allocator alignment so that each of them starts aligned
+  static size_t paddedSize() {
+    const size_t n = EcalAlignedAllocator<Field>::alignment / sizeof(Field);
+    return n > 1 ? (kSize + n - 1) / n * n : kSize;
+  }
+
+  Item get(size_t i) const {
+    if (i >= kSize) return Item();
+    Item item;
+    for (size_t k = 0; k < nFields; ++k) Layout::set(item, k, column(k)[i]);
+    return item;
+  }
+
+  void set(size_t i, const Item& item) {
+    if (i >= kSize) return;
+    for (size_t k = 0; k < nFields; ++k) column(k)[i] = Layout::get(item, k);
+  }
+
+  size_t stride_;
+  Columns data_;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef CondFormats_EcalObjects_EcalCondObjectContainerView_H
+#define CondFormats_EcalObjects_EcalCondObjectContainerView_H
+/**
+ * Fixed layout binary file format for EcalCondObjectContainer payloads,
+ * and a read-only view mapping such a file straight into memory.
+ *
+ * File layout (native endianness):
+ *   EcalCondObjectFile::Header   64 bytes: magic "ECALCOND", format version,
+ *                                item size, type tag, number of EB and EE
+ *                                items, FNV-1a 64 checksum of the data
+ *   EB items                     EBDetId::denseIndex order
+ *   EE items                     EEDetId::denseIndex order
+ * i.e. the items in ECAL dense index order (see EcalDenseIndex), as raw
+ * bytes: Item must be trivially copyable (float, EcalPedestal,
+ * EcalLaserAPDPNpair, ...).
+ *
+ *   EcalCondObjectFile::write(intercalib, "intercalib.bin", "float");
+ *   EcalCondObjectContainerView<float> ic("intercalib.bin", "float");
+ *   float c = ic[detId.rawId()];
+ *
+ * The view maps the file read-only and shared (mmap): all the processes
+ * of a node using the same file share one page-cached copy. It offers the
+ * accessors of EcalCondObjectContainer (barrelItems(), endcap(), find(),
+ * operator[], item(), ...) on the mapped data; the file must not be
+ * modified while mapped. Invalid files (wrong magic, version, item size,
+ * type tag, length or checksum) are rejected with a cms::Exception.
+ *
+ * Transient object, not copyable.
+ **/
+
+#include <string>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalCondObjectContainer.h"
+
+class EcalCondObjectFile {
+ public:
+  static const uint32_t kVersion = 1;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t itemSize;
+    char typeTag[24];
+    uint32_t nEB;
+    uint32_t nEE;
+    uint64_t checksum;
+    uint64_t reserved;
+  };
+  BOOST_STATIC_ASSERT(sizeof(Header) == 64);
+
+  /// write the items of c, typeTag (up to 23 characters) identifying the item type
+  template <typename T>
+  static void write(const EcalCondObjectContainer<T>& c, const std::string& path, const std::string& typeTag) {
+    write(path, typeTag, sizeof(T),
+          c.barrelItems().empty() ? 0 : &c.barrelItems()[0], c.barrelItems().size(),
+          c.endcapItems().empty() ? 0 : &c.endcapItems()[0], c.endcapItems().size());
+  }
+
+  static void write(const std::string& path, const std::string& typeTag, uint32_t itemSize,
+                    const void* eb, uint32_t nEB, const void* ee, uint32_t nEE);
+
+  /// FNV-1a 64, h being the hash of the preceding bytes if any
+  static uint64_t checksum(const void* data, size_t size, uint64_t h = 14695981039346656037ULL);
+
+  /// read-only shared mapping of a whole file
+  class Mapping {
+   public:
+    explicit Mapping(const std::string& path);
+    ~Mapping();
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+   private:
+    Mapping(const Mapping&);
+    Mapping& operator=(const Mapping&);
+    const char* data_;
+    size_t size_;
+  };
+
+  /// check the header and the data of a mapped file, returns the header
+  static const Header& validate(const Mapping& m, uint32_t itemSize, const std::string& typeTag, bool verifyChecksum);
+};
+
+template <typename T>
+class EcalCondObjectContainerView {
+ public:
+  typedef T Item;
+  typedef Item value_type;
+  typedef EcalCondObjectContainerView<T> self;
+  typedef const Item* const_iterator;
+
+  /// contiguous range of items, stands for the Items vectors of the container
+  class Items {
+   public:
+    Items(const Item* first, size_t n) : first_(first), n_(n) {}
+    const Item& operator[](size_t i) const { return first_[i]; }
+    const_iterator begin() const { return first_; }
+    const_iterator end() const { return first_ + n_; }
+    size_t size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+   private:
+    const Item* first_;
+    size_t n_;
+  };
+
+  explicit EcalCondObjectContainerView(const std::string& path, const std::string& typeTag, bool verifyChecksum = true) :
+    mapping_(path)
+  {
+    const EcalCondObjectFile::Header& h = EcalCondObjectFile::validate(mapping_, sizeof(T), typeTag, verifyChecksum);
+    eb_ = reinterpret_cast<const Item*>(mapping_.data() + sizeof(EcalCondObjectFile::Header));
+    ee_ = eb_ + h.nEB;
+    nEB_ = h.nEB;
+    nEE_ = h.nEE;
+  }
+
+  Items barrelItems() const { return Items(eb_, nEB_); }
+  Items endcapItems() const { return Items(ee_, nEE_); }
+
+  const Item& barrel(size_t hashedIndex) const { return eb_[hashedIndex]; }
+  const Item& endcap(size_t hashedIndex) const { return ee_[hashedIndex]; }
+
+  /// item by dense index, a default item for indices without data
+  const Item& item(size_t denseIndex) const {
+    if (denseIndex < nEB_) return eb_[denseIndex];
+    const size_t i = denseIndex - EcalDenseIndex::kEBSize;
+    return denseIndex >= EcalDenseIndex::kEBSize && i < nEE_ ? ee_[i] : dummy();
+  }
+
+  const Item& operator[](uint32_t rawId) const { return item(EcalDenseIndex::fromRawId(rawId)); }
+
+  /// as for EcalCondObjectContainer, begin() to end() runs over EB then EE
+  const_iterator find(uint32_t rawId) const {
+    const size_t i = EcalDenseIndex::fromRawId(rawId);
+    if (i < nEB_) return eb_ + i;
+    const size_t j = i - EcalDenseIndex::kEBSize;
+    return i >= EcalDenseIndex::kEBSize && j < nEE_ ? ee_ + j : end();
+  }
+
+  const_iterator begin() const { return eb_; }
+  const_iterator end() const { return ee_ + nEE_; }
+  size_t size() const { return nEB_ + nEE_; }
+
+  const self& getMap() const { return *this; }
+
+  static size_t denseIndex(uint32_t rawId) { return EcalDenseIndex::fromRawId(rawId); }
+
+  /// copy into a persistent container
+  EcalCondObjectContainer<T> toContainer() const {
+    EcalCondObjectContainer<T> c;
+    for (size_t i = 0; i < nEB_; ++i) c.setValue(EcalDenseIndex::toRawId(i), eb_[i]);
+    for (size_t i = 0; i < nEE_; ++i) c.setValue(EcalDenseIndex::toRawId(EcalDenseIndex::kEBSize + i), ee_[i]);
+    return c;
+  }
+
+ private:
+  EcalCondObjectContainerView(const EcalCondObjectContainerView&);
+  EcalCondObjectContainerView& operator=(const EcalCondObjectContainerView&);
+
+  static const Item& dummy() {
+    static const Item d = Item();
+    return d;
+  }
+
+  EcalCondObjectFile::Mapping mapping_;
+  const Item* eb_;
+  const Item* ee_;
+  size_t nEB_;
+  size_t nEE_;
+};
+
+#endif
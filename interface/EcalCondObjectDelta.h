@@ -0,0 +1,240 @@
+#ifndef CondFormats_EcalObjects_EcalCondObjectDelta_H
+#define CondFormats_EcalObjects_EcalCondObjectDelta_H
+/**
+ * Sparse difference between two payloads of the same crystal or tower
+ * container type, to step from one IOV to the next without reloading the
+ * whole payload.
+ *
+ * The items are numbered as in the containers: barrel items first, then
+ * endcap items (the ECAL dense index for EcalCondObjectContainer, the EB
+ * trigger tower then EE supercrystal hashed index for
+ * EcalCondTowerObjectContainer). The delta keeps the runs of consecutive
+ * changed items, (first index, length), and their new values:
+ *
+ *   EcalCondObjectDelta<float> d = EcalCondObjectDelta<float>::diff(icN, icN1);
+ *   d.write(out);                 // a few kB instead of 300
+ *   ...
+ *   d.read(in);
+ *   d.apply(ic);                  // ic now equal to icN1
+ *
+ * Items are compared and written byte by byte: T must be trivially
+ * copyable, without padding (float, EcalPedestal, EcalChannelStatusCode,
+ * ...). The delta records a checksum (FNV-1a 64) of the "from" payload:
+ * apply() throws unless the target has the same number of items and the
+ * same checksum. The binary form starts with a magic word and a format
+ * version, and read() rejects inconsistent contents (counts, run bounds)
+ * before allocating anything.
+ *
+ * Transient object.
+ **/
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalCondObjectContainer.h"
+#include "CondFormats/EcalObjects/interface/EcalCondTowerObjectContainer.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+template <typename T>
+class EcalCondObjectDelta {
+ public:
+  struct Run {
+    uint32_t first;
+    uint32_t length;
+  };
+
+  static const uint32_t kVersion = 1;
+
+  EcalCondObjectDelta() : nEB_(0), nEE_(0), baseChecksum_(kChecksumSeed) {}
+
+  static EcalCondObjectDelta diff(const EcalCondObjectContainer<T>& from, const EcalCondObjectContainer<T>& to) {
+    return diff(from.barrelItems(), from.endcapItems(), to.barrelItems(), to.endcapItems());
+  }
+
+  static EcalCondObjectDelta diff(const EcalCondTowerObjectContainer<T>& from, const EcalCondTowerObjectContainer<T>& to) {
+    return diff(from.barrelItems(), from.endcapItems(), to.barrelItems(), to.endcapItems());
+  }
+
+  /// turn c (equal to the "from" payload) into the "to" payload
+  void apply(EcalCondObjectContainer<T>& c) const {
+    check(c.barrelItems(), c.endcapItems());
+    for (size_t r = 0, v = 0; r < runs_.size(); ++r) {
+      for (uint32_t i = runs_[r].first; i < runs_[r].first + runs_[r].length; ++i, ++v) {
+        const uint32_t dense = i < nEB_ ? i : EcalDenseIndex::kEBSize + i - nEB_;
+        c.setValue(EcalDenseIndex::toRawId(dense), values_[v]);
+      }
+    }
+  }
+
+  void apply(EcalCondTowerObjectContainer<T>& c) const {
+    check(c.barrelItems(), c.endcapItems());
+    for (size_t r = 0, v = 0; r < runs_.size(); ++r) {
+      for (uint32_t i = runs_[r].first; i < runs_[r].first + runs_[r].length; ++i, ++v) {
+        const uint32_t rawId = i < nEB_ ? EcalTrigTowerDetId::detIdFromDenseIndex(i).rawId()
+                                        : EcalScDetId::unhashIndex(i - nEB_).rawId();
+        c.setValue(rawId, values_[v]);
+      }
+    }
+  }
+
+  bool empty() const { return runs_.empty(); }
+
+  /// number of changed items
+  size_t size() const { return values_.size(); }
+
+  const std::vector<Run>& runs() const { return runs_; }
+  const std::vector<T>& values() const { return values_; }
+
+  /// checksum of the items of the "from" payload
+  uint64_t baseChecksum() const { return baseChecksum_; }
+
+  /// binary form: header (magic, version, item size, sizes, base checksum), runs, values
+  void write(std::ostream& out) const {
+    Header h;
+    std::memcpy(h.magic, kMagic(), sizeof(h.magic));
+    h.version = kVersion;
+    h.itemSize = sizeof(T);
+    h.nEB = nEB_;
+    h.nEE = nEE_;
+    h.nRuns = runs_.size();
+    h.nValues = values_.size();
+    h.baseChecksum = baseChecksum_;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    if (!runs_.empty()) out.write(reinterpret_cast<const char*>(&runs_[0]), runs_.size() * sizeof(Run));
+    if (!values_.empty()) out.write(reinterpret_cast<const char*>(&values_[0]), values_.size() * sizeof(T));
+  }
+
+  /// throws on a stream which is not a consistent delta of T; the delta is unchanged then
+  void read(std::istream& in) {
+    Header h;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) {
+      throw cms::Exception("EcalCondObjectDelta") << "cannot read the delta header";
+    }
+    if (std::memcmp(h.magic, kMagic(), sizeof(h.magic)) != 0) {
+      throw cms::Exception("EcalCondObjectDelta") << "not a delta: bad magic";
+    }
+    if (h.version != kVersion || h.itemSize != sizeof(T)) {
+      throw cms::Exception("EcalCondObjectDelta") << "delta of version " << h.version << " and item size " << h.itemSize
+        << ", expected " << kVersion << " and " << sizeof(T);
+    }
+    // no ECAL container is larger than the crystal one
+    const uint64_t n = uint64_t(h.nEB) + h.nEE;
+    if (n > EcalDenseIndex::kSizeForDenseIndexing || h.nValues > n || h.nRuns > h.nValues) {
+      throw cms::Exception("EcalCondObjectDelta") << "inconsistent delta sizes: " << h.nEB << "+" << h.nEE
+        << " items, " << h.nRuns << " runs, " << h.nValues << " values";
+    }
+
+    std::vector<Run> runs(h.nRuns);
+    std::vector<T> values(h.nValues);
+    if ((!runs.empty() && !in.read(reinterpret_cast<char*>(&runs[0]), runs.size() * sizeof(Run)))
+        || (!values.empty() && !in.read(reinterpret_cast<char*>(&values[0]), values.size() * sizeof(T)))) {
+      throw cms::Exception("EcalCondObjectDelta") << "truncated delta";
+    }
+    // runs: non empty, increasing, not overlapping, within the items, covering the values
+    uint64_t end = 0, total = 0;
+    for (size_t r = 0; r < runs.size(); ++r) {
+      if (runs[r].length == 0 || runs[r].first < end || uint64_t(runs[r].first) + runs[r].length > n) {
+        throw cms::Exception("EcalCondObjectDelta") << "run " << r << " (" << runs[r].first << ", " << runs[r].length
+          << ") out of order or out of the " << n << " items";
+      }
+      end = uint64_t(runs[r].first) + runs[r].length;
+      total += runs[r].length;
+    }
+    if (total != values.size()) {
+      throw cms::Exception("EcalCondObjectDelta") << "the runs cover " << total << " items, for " << values.size() << " values";
+    }
+
+    nEB_ = h.nEB;
+    nEE_ = h.nEE;
+    baseChecksum_ = h.baseChecksum;
+    runs_.swap(runs);
+    values_.swap(values);
+  }
+
+ private:
+  template <typename Items>
+  static EcalCondObjectDelta diff(const Items& fromEB, const Items& fromEE, const Items& toEB, const Items& toEE) {
+    if (fromEB.size() != toEB.size() || fromEE.size() != toEE.size()) {
+      throw cms::Exception("EcalCondObjectDelta") << "payloads of different sizes: " << fromEB.size() << "+"
+        << fromEE.size() << " and " << toEB.size() << "+" << toEE.size() << " items";
+    }
+    EcalCondObjectDelta d;
+    d.nEB_ = toEB.size();
+    d.nEE_ = toEE.size();
+    d.baseChecksum_ = checksum(fromEB, fromEE);
+    d.scan(fromEB, toEB, 0);
+    d.scan(fromEE, toEE, d.nEB_);
+    return d;
+  }
+
+  template <typename Items>
+  void scan(const Items& from, const Items& to, uint32_t offset) {
+    for (uint32_t i = 0; i < to.size(); ++i) {
+      if (std::memcmp(&from[i], &to[i], sizeof(T)) == 0) continue;
+      if (!runs_.empty() && runs_.back().first + runs_.back().length == offset + i) {
+        ++runs_.back().length;
+      } else {
+        Run r = { offset + i, 1 };
+        runs_.push_back(r);
+      }
+      values_.push_back(to[i]);
+    }
+  }
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t itemSize;
+    uint32_t nEB;
+    uint32_t nEE;
+    uint32_t nRuns;
+    uint32_t nValues;
+    uint64_t baseChecksum;
+  };
+
+  static const char* kMagic() { return "ECALDELT"; }
+  static const uint64_t kChecksumSeed = 14695981039346656037ULL;
+
+  // FNV-1a 64 of the bytes of the EB then the EE items
+  template <typename Items>
+  static uint64_t checksum(const Items& eb, const Items& ee) {
+    uint64_t h = kChecksumSeed;
+    const Items* halves[2] = { &eb, &ee };
+    for (int k = 0; k < 2; ++k) {
+      const unsigned char* p = halves[k]->empty() ? 0 : reinterpret_cast<const unsigned char*>(&(*halves[k])[0]);
+      for (size_t i = 0; i < halves[k]->size() * sizeof(T); ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+      }
+    }
+    return h;
+  }
+
+  template <typename Items>
+  void check(const Items& eb, const Items& ee) const {
+    if (eb.size() != nEB_ || ee.size() != nEE_) {
+      throw cms::Exception("EcalCondObjectDelta") << "delta computed for " << nEB_ << "+" << nEE_
+        << " items, applied to a payload of " << eb.size() << "+" << ee.size();
+    }
+    if (checksum(eb, ee) != baseChecksum_) {
+      throw cms::Exception("EcalCondObjectDelta") << "delta applied to a payload other than the one it was computed from";
+    }
+  }
+
+  uint32_t nEB_;
+  uint32_t nEE_;
+  uint64_t baseChecksum_;
+  std::vector<Run> runs_;
+  std::vector<T> values_;
+};
+
+template <typename T>
+const uint32_t EcalCondObjectDelta<T>::kVersion;
+
+template <typename T>
+const uint64_t EcalCondObjectDelta<T>::kChecksumSeed;
+
+#endif
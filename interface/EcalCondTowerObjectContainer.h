@@ -19,9 +19,9 @@ class EcalCondTowerObjectContainer {
                 typedef typename std::vector<Item>::iterator iterator;
 
                 EcalCondTowerObjectContainer() {
-		  size_t ebsize=(size_t)EcalTrigTowerDetId::kEBTowersPerSM*18*2;
+		  size_t ebsize=(size_t)EcalTrigTowerDetId::kEBTotalTowers;
 		  eb_.checkAndResize(ebsize);
-		  size_t eesize=(size_t)632;
+		  size_t eesize=(size_t)EcalScDetId::kSizeForDenseIndexing;
 		  ee_.checkAndResize(eesize);
 		};
                 ~EcalCondTowerObjectContainer() {};
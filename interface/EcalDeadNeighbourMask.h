@@ -0,0 +1,61 @@
+#ifndef CondFormats_EcalObjects_EcalDeadNeighbourMask_H
+#define CondFormats_EcalObjects_EcalDeadNeighbourMask_H
+/**
+ * Bad crystals in the 5x5 window around each crystal, from EcalChannelStatus.
+ *
+ * For every crystal a 32 bit word tells which of the 25 crystals of the 5x5
+ * window centred on it are bad, a crystal being bad when its decoded status
+ * code is at least minStatus (by default 10: fixed gain 0 and the non
+ * responding types). Bit bit(d1, d2), d1 and d2 in [-2, 2], is the crystal
+ * at offset (d1, d2):
+ *  - EB: d1 along ieta (skipping ieta = 0), d2 along iphi (wrapping around);
+ *  - EE: d1 along ix, d2 along iy, in the same endcap.
+ * Positions outside of the detector are never bad. The window does not
+ * cross the EB/EE transition: EB and EE crystals on either side of it are
+ * not neighbours here, as matching them needs the geometry. The masks of
+ * the EB crystals with |ieta| >= 84 and of the outermost EE rings do not
+ * see the bad crystals across the transition. Callers that need them
+ * should check those crystals with the CaloTopology.
+ *
+ *   EcalDeadNeighbourMask dead(channelStatus);
+ *   uint32_t m = dead.mask(seed.rawId());
+ *   if (m & EcalDeadNeighbourMask::k3x3Ring) ...  // a bad crystal touches the seed
+ *
+ * The masks are built once per IOV (a few milliseconds). Transient object.
+ **/
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalChannelStatus.h"
+
+class EcalDeadNeighbourMask {
+ public:
+  static const uint32_t kCentre = 1u << 12;  // bit(0, 0)
+  static const uint32_t k3x3 = 0x000739c0;    // |d1|, |d2| <= 1
+  static const uint32_t k3x3Ring = k3x3 & ~kCentre;
+  static const uint32_t k5x5 = 0x01ffffff;
+  static const uint32_t k5x5Ring = k5x5 & ~k3x3;
+
+  explicit EcalDeadNeighbourMask(const EcalChannelStatus& status, int minStatus = 10);
+
+  /// 5x5 bad crystal mask of a crystal, 0 for ids which are not ECAL crystals
+  uint32_t mask(uint32_t rawId) const { return masks_[EcalDenseIndex::fromRawId(rawId)]; }
+
+  /// same by dense index
+  uint32_t item(uint32_t denseIndex) const { return masks_[denseIndex]; }
+
+  int minStatus() const { return minStatus_; }
+
+  /// bit of the crystal at offset (d1, d2) from the centre
+  static uint32_t bit(int d1, int d2) { return 1u << ((d1 + 2) * 5 + d2 + 2); }
+
+ private:
+  void fillBarrel(const std::vector<uint8_t>& bad);
+  void fillEndcap(const std::vector<uint8_t>& bad);
+
+  int minStatus_;
+  std::vector<uint32_t> masks_;  // kSizeForDenseIndexing + 1 entries, the last one for invalid ids
+};
+
+#endif
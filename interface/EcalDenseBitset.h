@@ -0,0 +1,163 @@
+#ifndef CondFormats_EcalObjects_EcalDenseBitset_H
+#define CondFormats_EcalObjects_EcalDenseBitset_H
+/**
+ * Packed set of ECAL crystals, one bit per crystal in dense index order
+ * (see EcalDenseIndex), 64 crystals per word.
+ *
+ * Besides test/set, it supports the set algebra (&, |, ^, andNot, ~ limited
+ * to the ECAL crystals), counting with popcount and iteration over the
+ * crystals in the set, skipping empty words:
+ *
+ *   for (uint32_t i : dead) ... EcalDenseIndex::toRawId(i) ...
+ *
+ * Transient helper.
+ **/
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+
+class EcalDenseBitset {
+ public:
+  typedef uint64_t Word;
+  static const uint32_t kSize = EcalDenseIndex::kSizeForDenseIndexing;
+  static const uint32_t kWordBits = 64;
+  static const uint32_t kWords = (kSize + kWordBits - 1) / kWordBits;
+
+  /// index of the lowest set bit of a non-zero word
+  static uint32_t lowestBit(Word w) {
+#if defined(__GNUC__) && !defined(__GCCXML__)
+    return __builtin_ctzll(w);
+#else
+    uint32_t n = 0;
+    for (; !(w & 1); w >>= 1) ++n;
+    return n;
+#endif
+  }
+
+  /// number of set bits of a word
+  static uint32_t popcount(Word w) {
+#if defined(__GNUC__) && !defined(__GCCXML__)
+    return __builtin_popcountll(w);
+#else
+    w -= (w >> 1) & 0x5555555555555555ULL;
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return uint32_t((w * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+
+  /// forward iterator on the dense indices of the crystals in the set
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef uint32_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef uint32_t reference;
+
+    const_iterator(const Word* words, uint32_t w) : words_(words), w_(w), bits_(w < kWords ? words[w] : 0) { skip(); }
+    uint32_t operator*() const { return w_ * kWordBits + lowestBit(bits_); }
+    const_iterator& operator++() { bits_ &= bits_ - 1; skip(); return *this; }
+    const_iterator operator++(int) { const_iterator t(*this); ++(*this); return t; }
+    bool operator==(const const_iterator& o) const { return w_ == o.w_ && bits_ == o.bits_; }
+    bool operator!=(const const_iterator& o) const { return !(*this == o); }
+   private:
+    void skip() {
+      while (bits_ == 0 && w_ < kWords) {
+        ++w_;
+        bits_ = w_ < kWords ? words_[w_] : 0;
+      }
+    }
+    const Word* words_;
+    uint32_t w_;
+    Word bits_;
+  };
+
+  EcalDenseBitset() : words_(kWords, 0) {}
+
+  bool test(uint32_t i) const { return i < kSize && (words_[i / kWordBits] >> (i % kWordBits)) & 1; }
+
+  void set(uint32_t i, bool value = true) {
+    if (i >= kSize) return;
+    const Word bit = Word(1) << (i % kWordBits);
+    words_[i / kWordBits] = value ? words_[i / kWordBits] | bit : words_[i / kWordBits] & ~bit;
+  }
+
+  void reset() { words_.assign(kWords, 0); }
+
+  /// number of crystals in the set
+  uint32_t count() const {
+    uint32_t n = 0;
+    for (uint32_t w = 0; w < kWords; ++w) n += popcount(words_[w]);
+    return n;
+  }
+
+  bool any() const {
+    for (uint32_t w = 0; w < kWords; ++w) {
+      if (words_[w]) return true;
+    }
+    return false;
+  }
+
+  bool none() const { return !any(); }
+
+  /// number of crystals in both sets, without building the intersection
+  uint32_t countAnd(const EcalDenseBitset& o) const {
+    uint32_t n = 0;
+    for (uint32_t w = 0; w < kWords; ++w) n += popcount(words_[w] & o.words_[w]);
+    return n;
+  }
+
+  EcalDenseBitset& operator&=(const EcalDenseBitset& o) {
+    for (uint32_t w = 0; w < kWords; ++w) words_[w] &= o.words_[w];
+    return *this;
+  }
+  EcalDenseBitset& operator|=(const EcalDenseBitset& o) {
+    for (uint32_t w = 0; w < kWords; ++w) words_[w] |= o.words_[w];
+    return *this;
+  }
+  EcalDenseBitset& operator^=(const EcalDenseBitset& o) {
+    for (uint32_t w = 0; w < kWords; ++w) words_[w] ^= o.words_[w];
+    return *this;
+  }
+  /// remove the crystals of o
+  EcalDenseBitset& andNot(const EcalDenseBitset& o) {
+    for (uint32_t w = 0; w < kWords; ++w) words_[w] &= ~o.words_[w];
+    return *this;
+  }
+
+  EcalDenseBitset operator&(const EcalDenseBitset& o) const { EcalDenseBitset r(*this); return r &= o; }
+  EcalDenseBitset operator|(const EcalDenseBitset& o) const { EcalDenseBitset r(*this); return r |= o; }
+  EcalDenseBitset operator^(const EcalDenseBitset& o) const { EcalDenseBitset r(*this); return r ^= o; }
+
+  /// complement within the ECAL crystals
+  EcalDenseBitset operator~() const {
+    EcalDenseBitset r;
+    for (uint32_t w = 0; w < kWords; ++w) r.words_[w] = ~words_[w];
+    if (kSize % kWordBits) r.words_[kWords - 1] &= (Word(1) << (kSize % kWordBits)) - 1;
+    return r;
+  }
+
+  bool operator==(const EcalDenseBitset& o) const { return words_ == o.words_; }
+  bool operator!=(const EcalDenseBitset& o) const { return words_ != o.words_; }
+
+  const_iterator begin() const { return const_iterator(&words_[0], 0); }
+  const_iterator end() const { return const_iterator(&words_[0], kWords); }
+
+  /// raw ids of the crystals in the set, appended to rawIds
+  void rawIds(std::vector<uint32_t>& rawIds) const {
+    for (const_iterator it = begin(); it != end(); ++it) rawIds.push_back(EcalDenseIndex::toRawId(*it));
+  }
+
+  const Word* words() const { return &words_[0]; }
+  Word* words() { return &words_[0]; }
+
+ private:
+  std::vector<Word> words_;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef CondFormats_EcalObjects_EcalDenseIndex_H
+#define CondFormats_EcalObjects_EcalDenseIndex_H
+/**
+ * Conversion of ECAL crystal raw ids to the unified dense index
+ *   0 .. 61199      EB crystals, EBDetId::denseIndex()
+ *   61200 .. 75847  EE crystals, EEDetId::denseIndex() + 61200
+ * the same convention used for the 75848 element vectors of EcalSRSettings.
+ *
+ * The conversion works directly on the raw id bits and does not branch on
+ * the subdetector: the barrel index is computed arithmetically, the endcap
+ * one is read from a 32k entry table filled when the library is loaded.
+ * Ids which are not ECAL crystals give kSizeForDenseIndexing.
+ *
+ * The table is filled by a static initializer: do not use this class from
+ * other static initializers.
+ **/
+
+#include <cstddef>
+#include <boost/cstdint.hpp>
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+
+class EcalDenseIndex {
+ public:
+  static const uint32_t kEBSize = EBDetId::kSizeForDenseIndexing;
+  static const uint32_t kEESize = EEDetId::kSizeForDenseIndexing;
+  static const uint32_t kSizeForDenseIndexing = kEBSize + kEESize;
+
+  /// dense index of rawId, kSizeForDenseIndexing if it is not an ECAL crystal
+  static inline uint32_t fromRawId(uint32_t rawId) {
+    const uint32_t det = rawId >> 28;
+    const uint32_t subdet = (rawId >> 25) & 0x7;
+
+    // EB: zside bit 16, |ieta| bits 9-15, iphi bits 0-8
+    const uint32_t z = (rawId >> 16) & 0x1;
+    const uint32_t ietaAbs = (rawId >> 9) & 0x7F;
+    const uint32_t iphi = rawId & 0x1FF;
+    const uint32_t eb = (EBDetId::MAX_IETA - ietaAbs + z * (2 * ietaAbs - 1)) * EBDetId::MAX_IPHI + iphi - 1;
+    const uint32_t isEB = (det == DetId::Ecal) & (subdet == EcalBarrel) & ((rawId & 0x01FE0000) == 0)
+      & (ietaAbs - 1 < uint32_t(EBDetId::MAX_IETA)) & (iphi - 1 < uint32_t(EBDetId::MAX_IPHI));
+
+    // EE: zside bit 14, ix bits 7-13, iy bits 0-6, table holds denseIndex+1 (0 = invalid)
+    const uint32_t ee = eeTable_[rawId & (kEETableSize - 1)];
+    const uint32_t isEE = (det == DetId::Ecal) & (subdet == EcalEndcap) & ((rawId & 0x01FF8000) == 0) & (ee != 0);
+
+    const uint32_t isNone = 1 - (isEB | isEE);
+    return (eb & (0 - isEB)) | ((kEBSize + ee - 1) & (0 - isEE)) | (kSizeForDenseIndexing & (0 - isNone));
+  }
+
+  /// batch version of fromRawId
+  static void fromRawIds(const uint32_t* rawIds, size_t n, uint32_t* denseIndices);
+
+  /// raw id of a dense index, 0 if out of range
+  static uint32_t toRawId(uint32_t denseIndex);
+
+  static bool isBarrel(uint32_t denseIndex) { return denseIndex < kEBSize; }
+  static bool isEndcap(uint32_t denseIndex) { return denseIndex - kEBSize < kEESize; }
+
+ private:
+  static const uint32_t kEETableSize = 0x8000;
+  static uint16_t eeTable_[kEETableSize];
+  friend struct EcalDenseIndexTableFiller;
+};
+
+#endif
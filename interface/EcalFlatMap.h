@@ -0,0 +1,156 @@
+#ifndef CondFormats_EcalObjects_EcalFlatMap_H
+#define CondFormats_EcalObjects_EcalFlatMap_H
+/**
+ * Read-only flat replacement for the std::map<uint32_t, X> used by the TPG
+ * payloads (EcalTPGGroups, EcalTPGSpike, EcalTPGStripStatus, ...).
+ *
+ * The (key, value) pairs are stored sorted in a single contiguous vector, so
+ * that iteration is the same as for the std::map but without one node
+ * allocation per entry. Lookups go through a copy of the keys in Eytzinger
+ * (BFS) order: the search descends the implicit tree without branches on
+ * the comparison and touches at most log2(n) consecutive cache lines.
+ *
+ * The map is built in bulk, with one allocation per array, from the
+ * persistent std::map:
+ *
+ *   const EcalFlatMap<uint32_t, uint16_t> & flat = towerStatus.getFlatMap();
+ *   EcalFlatMap<uint32_t, uint16_t>::const_iterator it = flat.find(towerId);
+ *   if (it != flat.end()) status = it->second;
+ *
+ * Only the lookup latency is addressed: the persistent std::map is kept,
+ * so the database I/O and the memory of the std::map are unchanged, and
+ * the flat map comes on top of them (about 12 bytes plus the value per
+ * entry, built once in O(n) on first use, once the payload is complete).
+ *
+ * Transient object, see EcalFlatMapCache for how it is attached to the
+ * persistent payloads.
+ **/
+
+#include <map>
+#include <vector>
+#include <utility>
+#include <boost/cstdint.hpp>
+
+template <typename K, typename V>
+class EcalFlatMap {
+ public:
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef std::pair<K, V> value_type;
+  typedef std::vector<value_type> Items;
+  typedef typename Items::const_iterator const_iterator;
+
+  EcalFlatMap() : keys_(1), pos_(1) {}
+
+  explicit EcalFlatMap(const std::map<K, V>& m) : items_(m.begin(), m.end()), keys_(m.size() + 1), pos_(m.size() + 1) {
+    size_t next = 0;
+    fill(1, next);
+  }
+
+  const_iterator begin() const { return items_.begin(); }
+  const_iterator end() const { return items_.end(); }
+  size_t size() const { return items_.size(); }
+  bool empty() const { return items_.empty(); }
+
+  /// sorted (key, value) pairs
+  const Items& items() const { return items_; }
+
+  const_iterator find(const K& key) const {
+    size_t i = lowerBoundIndex(key);
+    return i < items_.size() && !(key < items_[i].first) ? items_.begin() + i : items_.end();
+  }
+
+  const_iterator lower_bound(const K& key) const { return items_.begin() + lowerBoundIndex(key); }
+
+  size_t count(const K& key) const { return find(key) != end() ? 1 : 0; }
+
+  /// value associated to key, def if the key is not in the map
+  V value(const K& key, const V& def = V()) const {
+    const_iterator it = find(key);
+    return it != end() ? it->second : def;
+  }
+
+ private:
+  // in-order visit of the implicit tree, assigning the sorted elements to the BFS slots
+  void fill(size_t k, size_t& next) {
+    if (k >= keys_.size()) return;
+    fill(2 * k, next);
+    keys_[k] = items_[next].first;
+    pos_[k] = next++;
+    fill(2 * k + 1, next);
+  }
+
+  size_t lowerBoundIndex(const K& key) const {
+    const size_t n = items_.size();
+    size_t k = 1;
+    while (k <= n) k = 2 * k + (keys_[k] < key);
+    // the lower bound is the last node where the search went left: drop the trailing right turns and that left turn
+#if defined(__GNUC__) && !defined(__GCCXML__)
+    k >>= __builtin_ffsll(~(unsigned long long)k);
+#else
+    while (k & 1) k >>= 1;
+    k >>= 1;
+#endif
+    return k == 0 ? n : pos_[k];
+  }
+
+  Items items_;
+  std::vector<K> keys_;        // Eytzinger order, slot 0 unused
+  std::vector<uint32_t> pos_;  // position in items_ of each slot of keys_
+};
+
+/**
+ * Holder of the EcalFlatMap twin of a persistent std::map, as a transient
+ * data member of the payload. The flat map is built on the first call to
+ * get() (the database I/O fills the std::map directly, without calling
+ * any hook), concurrent first calls are safe.
+ *
+ * The payload is complete once its flat map is built: the owner must not
+ * modify the std::map any more, and its setValue() throws if built() is
+ * true. Nothing is ever rebuilt, so references returned by get() stay
+ * valid as long as the payload. Copies start empty, and can be modified
+ * again; assigning to a payload frees its flat map, which must then not be
+ * in use.
+ **/
+template <typename K, typename V>
+class EcalFlatMapCache {
+ public:
+  typedef EcalFlatMap<K, V> Map;
+
+  EcalFlatMapCache() : map_(0) {}
+  EcalFlatMapCache(const EcalFlatMapCache&) : map_(0) {}
+  EcalFlatMapCache& operator=(const EcalFlatMapCache&) {
+    delete map_;
+    map_ = 0;
+    return *this;
+  }
+  ~EcalFlatMapCache() { delete map_; }
+
+  const Map& get(const std::map<K, V>& m) const {
+    Map* p = load();
+    if (p) return *p;
+    Map* fresh = new Map(m);
+#if defined(__GNUC__) && !defined(__GCCXML__)
+    if (!__sync_bool_compare_and_swap(&map_, (Map*)0, fresh)) delete fresh;
+#else
+    map_ = fresh;
+#endif
+    return *load();
+  }
+
+  /// true once get() has been called: the std::map is then frozen
+  bool built() const { return load() != 0; }
+
+ private:
+  Map* load() const {
+#if defined(__GNUC__) && !defined(__GCCXML__)
+    return __atomic_load_n(&map_, __ATOMIC_ACQUIRE);
+#else
+    return map_;
+#endif
+  }
+
+  mutable Map* map_;
+};
+
+#endif
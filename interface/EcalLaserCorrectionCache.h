@@ -0,0 +1,73 @@
+#ifndef CondFormats_EcalObjects_EcalLaserCorrectionCache_H
+#define CondFormats_EcalObjects_EcalLaserCorrectionCache_H
+/**
+ * Memoization of the per-crystal time dependent corrections.
+ *
+ * Corrections are evaluated once per (IOV token, time bucket) and shared,
+ * read-only, by all the callers asking for an event time falling in the
+ * same bucket, whichever thread or stream they run in. The IOV token is any
+ * number identifying the input payloads, typically the cacheIdentifier()
+ * of the EventSetup record.
+ *
+ * Time buckets are bucketWidth seconds wide, seconds being the upper 32 bits
+ * of edm::Timestamp::value() as for collision data; the corrections of a
+ * bucket are evaluated at its center. The default width, 23 s, is about one
+ * lumisection. A bucket width of 0 disables the
+ * bucketing: each distinct time is its own bucket.
+ *
+ * The corrections are computed by the given function (e.g. an
+ * EcalLaserCorrectionEngine, or the interpolation of EcalLinearCorrections).
+ * A bucket is computed by the first thread asking for it, outside of the
+ * cache lock; concurrent requests for the same bucket wait for it. At most
+ * maxEntries buckets are kept, the least recently used being dropped first.
+ *
+ * The header is C++03 (boost::shared_ptr and boost::function); the lock and
+ * the pending evaluations live in the implementation.
+ **/
+
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "DataFormats/Provenance/interface/Timestamp.h"
+
+class EcalLaserCorrectionEngine;
+
+class EcalLaserCorrectionCache {
+ public:
+  typedef std::vector<float> Corrections;
+  typedef boost::shared_ptr<const Corrections> CorrectionsPtr;
+  typedef boost::function<void (edm::Timestamp, Corrections&)> Evaluator;
+
+  explicit EcalLaserCorrectionCache(unsigned int bucketWidth = 23, size_t maxEntries = 8);
+  ~EcalLaserCorrectionCache();
+
+  /// corrections for iovToken at time t, computed with evaluate if not cached yet
+  CorrectionsPtr get(unsigned long long iovToken, edm::Timestamp t, const Evaluator& evaluate);
+
+  /// same, with the corrections computed by engine
+  CorrectionsPtr get(unsigned long long iovToken, edm::Timestamp t, const EcalLaserCorrectionEngine& engine);
+
+  /// time at which the corrections of the bucket containing t are evaluated
+  edm::Timestamp bucketTime(edm::Timestamp t) const;
+
+  unsigned int bucketWidth() const { return bucketWidth_; }
+  size_t maxEntries() const { return maxEntries_; }
+
+  /// number of evaluations done so far (cache misses)
+  unsigned long long evaluations() const;
+
+  void clear();
+
+ private:
+  EcalLaserCorrectionCache(const EcalLaserCorrectionCache&);
+  EcalLaserCorrectionCache& operator=(const EcalLaserCorrectionCache&);
+
+  struct Impl;  // the entries and their lock
+
+  const unsigned int bucketWidth_;
+  const size_t maxEntries_;
+  Impl* impl_;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef CondFormats_EcalObjects_EcalLaserCorrectionEngine_H
+#define CondFormats_EcalObjects_EcalLaserCorrectionEngine_H
+/**
+ * Batch evaluation of the laser correction of all the ECAL crystals.
+ *
+ * For each crystal the APD/PN ratio is linearly interpolated at time t
+ * between (t1,p1), (t2,p2), (t3,p3), the times being those of the laser
+ * region of the crystal, and the correction is
+ *
+ *   1 / (APDPN(t) / APDPNref)^alpha
+ *
+ * (1 if the reference or the interpolated ratio is not positive). Before
+ * t1 the ratio is p1, after t3 it is p3.
+ *
+ * The constructor copies the payloads in aligned per-field arrays in ECAL
+ * dense index order (see EcalDenseIndex); compute() then works on whole
+ * SIMD vectors (see EcalSimd.h): the 92 region weights are computed once,
+ * the per-crystal part is branch free, and pow() is evaluated as
+ * exp(alpha * (log(ref) - log(ratio))) with log(ref) precomputed. On
+ * x86 the vector width is that of the running cpu (AVX2 or AVX-512), not
+ * only that of the compilation flags.
+ *
+ * The crystal to laser region map (0..91, index in the time map of
+ * EcalLaserAPDPNRatios) is given by the user, as it lives outside of this
+ * package. Crystals with a region out of range get a correction of 1.
+ *
+ * Transient object. compute() is const and can be called concurrently.
+ **/
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalAlignedAllocator.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+#include "CondFormats/EcalObjects/interface/EcalLaserAPDPNRatios.h"
+#include "CondFormats/EcalObjects/interface/EcalLaserAPDPNRatiosRef.h"
+#include "CondFormats/EcalObjects/interface/EcalLaserAlphas.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+
+class EcalLaserCorrectionEngine {
+ public:
+  typedef std::vector<float, EcalAlignedAllocator<float> > FloatColumn;
+  typedef std::vector<int32_t, EcalAlignedAllocator<int32_t> > IntColumn;
+
+  /// apdpnRef and alphas may be null: reference 1 and alpha 1 are then used
+  EcalLaserCorrectionEngine(const EcalLaserAPDPNRatios& apdpn,
+                            const EcalLaserAPDPNRatiosRef* apdpnRef,
+                            const EcalLaserAlphas* alphas,
+                            const std::vector<uint8_t>& laserRegions);
+
+  /// corrections of the EcalDenseIndex::kSizeForDenseIndexing crystals at time t, by dense index
+  void compute(edm::Timestamp t, float* corrections) const;
+  void compute(edm::Timestamp t, std::vector<float>& corrections) const;
+
+  /// correction of a single crystal, reference implementation of compute()
+  static float correction(const EcalLaserAPDPNRatios::EcalLaserAPDPNpair& p,
+                          const EcalLaserAPDPNRatios::EcalLaserTimeStamp& ts,
+                          float apdpnRef, float alpha, edm::Timestamp t);
+
+  /// number of crystals processed at once by compute()
+  static int simdWidth();
+
+  size_t size() const { return EcalDenseIndex::kSizeForDenseIndexing; }
+
+ private:
+  // interpolation weight of a region at time t, and whether t is past t2
+  static void regionWeight(const EcalLaserAPDPNRatios::EcalLaserTimeStamp& ts, edm::Timestamp t,
+                           float& weight, int32_t& secondSegment);
+
+  EcalLaserAPDPNRatios::EcalLaserTimeStampMap times_;
+  FloatColumn p1_, p2_, p3_, logRef_, alpha_;
+  IntColumn region_;  // region of the crystal, times_.size() if none
+  IntColumn valid_;   // -1 if the reference is positive, 0 otherwise
+};
+
+#endif
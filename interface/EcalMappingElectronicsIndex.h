@@ -0,0 +1,129 @@
+#ifndef CondFormats_EcalObjects_EcalMappingElectronicsIndex_H
+#define CondFormats_EcalObjects_EcalMappingElectronicsIndex_H
+/**
+ * Reverse lookups of EcalMappingElectronics: electronics id -> crystal and
+ * trigger tower -> crystals.
+ *
+ * EcalMappingElectronics maps each crystal to its electronics id (DCC,
+ * tower, strip, crystal) and trigger electronics id (TCC, trigger tower,
+ * pseudo strip, channel). This index holds
+ *  - a dense array over (DCC, tower, strip, crystal) with the raw id of
+ *    the crystal read out there, 0 if none, for the unpacker;
+ *  - a CSR table over (TCC, trigger tower): the crystals of each trigger
+ *    tower, in dense index order (EcalDenseIndex), contiguous.
+ *
+ *   const EcalMappingElectronicsIndex & index = cache.get(mapping, record.cacheIdentifier());
+ *   uint32_t rawId = index.detId(EcalElectronicsId(dcc, tower, strip, xtal));
+ *   EcalMappingElectronicsIndex::Range xtals = index.crystals(tcc, tt);
+ *   for (const uint32_t * p = xtals.first; p != xtals.second; ++p) use(*p);
+ *
+ * Ids beyond the ranges of the arrays give 0 and an empty range; a mapping
+ * with such ids throws. The index is immutable once built and can be shared
+ * by threads. EcalMappingElectronicsIndexCache builds it on first use, and
+ * again when the mapping payload changes.
+ *
+ * Transient object.
+ **/
+
+#include <utility>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalMappingElectronics.h"
+#include "DataFormats/EcalDetId/interface/EcalElectronicsId.h"
+#include "DataFormats/EcalDetId/interface/EcalTriggerElectronicsId.h"
+
+class EcalMappingElectronicsIndex {
+ public:
+  static const uint32_t kDccs = 54;
+  static const uint32_t kTowers = 70;   // towers (CCUs) per DCC
+  static const uint32_t kStrips = 5;
+  static const uint32_t kXtals = 5;
+  static const uint32_t kTccs = 108;
+  static const uint32_t kTriggerTowers = 70;  // per TCC
+  static const uint32_t kElectronicsSize = kDccs * kTowers * kStrips * kXtals;
+  static const uint32_t kTriggerSize = kTccs * kTriggerTowers;
+
+  typedef std::pair<const uint32_t*, const uint32_t*> Range;
+
+  explicit EcalMappingElectronicsIndex(const EcalMappingElectronics& mapping);
+
+  /// dense index of an electronics id, kElectronicsSize if out of range
+  static uint32_t electronicsIndex(int dcc, int tower, int strip, int xtal) {
+    const uint32_t d = dcc - 1, t = tower - 1, s = strip - 1, x = xtal - 1;
+    return d < kDccs && t < kTowers && s < kStrips && x < kXtals
+      ? ((d * kTowers + t) * kStrips + s) * kXtals + x : kElectronicsSize;
+  }
+
+  /// dense index of a trigger tower, kTriggerSize if out of range
+  static uint32_t triggerTowerIndex(int tcc, int tt) {
+    const uint32_t c = tcc - 1, t = tt - 1;
+    return c < kTccs && t < kTriggerTowers ? c * kTriggerTowers + t : kTriggerSize;
+  }
+
+  /// raw id of the crystal read out at an electronics id, 0 if none
+  uint32_t detId(int dcc, int tower, int strip, int xtal) const { return detIds_[electronicsIndex(dcc, tower, strip, xtal)]; }
+  uint32_t detId(const EcalElectronicsId& id) const { return detId(id.dccId(), id.towerId(), id.stripId(), id.xtalId()); }
+
+  /// raw ids of the crystals of a trigger tower
+  Range crystals(int tcc, int tt) const {
+    const uint32_t i = triggerTowerIndex(tcc, tt);
+    return Range(&crystals_[0] + offsets_[i], &crystals_[0] + offsets_[i + 1]);
+  }
+  Range crystals(const EcalTriggerElectronicsId& id) const { return crystals(id.tccId(), id.ttId()); }
+
+  /// number of crystals in the mapping
+  size_t size() const { return crystals_.size() - 1; }
+
+ private:
+  std::vector<uint32_t> detIds_;   // kElectronicsSize + 1 entries, the last one 0
+  std::vector<uint32_t> offsets_;  // kTriggerSize + 2 entries, the last trigger tower empty
+  std::vector<uint32_t> crystals_; // plus one entry, so that &crystals_[0] is always valid
+};
+
+/**
+ * Holder of the EcalMappingElectronicsIndex of the current mapping payload.
+ * The index remembers the payload it was built from (its address and an
+ * optional IOV token, e.g. the cacheIdentifier() of the record) and get()
+ * builds a new one when called with another payload or token; concurrent
+ * calls are safe. Pass the token when payloads can be freed and another
+ * one allocated at the same address: with the default 0, only the address
+ * is compared.
+ *
+ * The indices replaced are kept until the holder is destroyed, so that
+ * references returned by earlier get() calls stay valid; the mapping
+ * changes rarely (one index per IOV). Copies start empty.
+ **/
+class EcalMappingElectronicsIndexCache {
+ public:
+  EcalMappingElectronicsIndexCache() : entry_(0) {}
+  EcalMappingElectronicsIndexCache(const EcalMappingElectronicsIndexCache&) : entry_(0) {}
+  /// drops the indices, which must not be in use
+  EcalMappingElectronicsIndexCache& operator=(const EcalMappingElectronicsIndexCache&) {
+    delete entry_;
+    entry_ = 0;
+    return *this;
+  }
+  ~EcalMappingElectronicsIndexCache() { delete entry_; }
+
+  const EcalMappingElectronicsIndex& get(const EcalMappingElectronics& mapping, unsigned long long iovToken = 0) const;
+
+ private:
+  struct Entry {
+    Entry(const EcalMappingElectronics& mapping, unsigned long long iovToken, Entry* replaced) :
+      source(&mapping), token(iovToken), index(mapping), previous(replaced) {}
+    ~Entry() { delete previous; }
+
+    const EcalMappingElectronics* source;
+    unsigned long long token;
+    EcalMappingElectronicsIndex index;
+    Entry* previous;  // the entry this one replaced, kept alive
+   private:
+    Entry(const Entry&);
+    Entry& operator=(const Entry&);
+  };
+
+  mutable Entry* entry_;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include <vector>
 #include <string>
 #include <ostream>
+#include <istream>
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
@@ -220,4 +221,15 @@ public:
 
 std::ostream& operator<< (std::ostream& o, const EcalSRSettings& val);
 
+/** Compact binary form of the settings, for archival and comparison tools.
+ * Vectors are length-prefixed and run-length encoded, integers are zigzag
+ * varints and floats are stored bit exact (IEEE 754 bit pattern, little
+ * endian whatever the host), so that the 75848-element modes of mostly
+ * constant settings take a few bytes. The writer streams directly to o.
+ * readBinary() replaces all the settings of val and throws a
+ * cms::Exception on a malformed or truncated input.
+ */
+void writeBinary(std::ostream& o, const EcalSRSettings& val);
+void readBinary(std::istream& i, EcalSRSettings& val);
+
 #endif //ECALSRSETTINGS_H not defined
@@ -0,0 +1,95 @@
+#ifndef CondFormats_EcalObjects_EcalSRSettingsTable_H
+#define CondFormats_EcalObjects_EcalSRSettingsTable_H
+/**
+ * Zero suppression settings of EcalSRSettings resolved per crystal.
+ *
+ * The ZS settings of EcalSRSettings (ecalDccZs1stSample_,
+ * dccNormalizedWeights_, symetricZS_, srpLowInterestChannelZS_,
+ * srpHighInterestChannelZS_) are vectors of 1 (whole ECAL), 2 (EB, EE),
+ * 54 (DCC) or 75848 (crystal, dense index) elements. This table applies
+ * that rule once per IOV and stores, for every crystal in dense index order
+ * (EcalDenseIndex), the values in the units of the DCC hardware:
+ *  - firstSample: index (from 0) of the first sample of the FIR filter;
+ *  - weightSet: slot of the filter in weightSets(); the kNWeights weights
+ *    are integers, lround(w * 1024), clamped to the 12 bit signed range;
+ *  - thresholdLow/High: lround(thr * 4 / adcToGeV) (the FIR output has two
+ *    fractional bits), INT_MAX when above the 12 bit signed range (kept
+ *    only on a gain switch), INT_MIN when below (always kept);
+ *  - symmetric: -1 if the cut is on the absolute value, 0 otherwise.
+ * The arrays are separate and aligned, one entry per crystal plus one for
+ * invalid ids (thresholds INT_MIN, first sample 0, weight slot 0), for
+ * vectorized loops.
+ *
+ *   EcalSRSettingsTable zs(srSettings, mappingElectronics);
+ *   uint32_t d = EcalDenseIndex::fromRawId(id);
+ *   const int32_t * w = zs.weights(zs.weightSet(d));
+ *
+ * The DCC of each crystal, for the 54 element mode, comes from the
+ * electronics mapping. Settings of another length throw. See
+ * EcalSRZeroSuppressor for the filter itself.
+ *
+ * Transient object: the payloads are not needed after construction.
+ **/
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalAlignedAllocator.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+#include "CondFormats/EcalObjects/interface/EcalMappingElectronics.h"
+#include "CondFormats/EcalObjects/interface/EcalSRSettings.h"
+
+class EcalSRSettingsTable {
+ public:
+  static const unsigned int kNWeights = 6;
+  static const int32_t kWeightScale = 1024;
+  static const int32_t kThresholdScale = 4;
+  static const int32_t kMinHwValue = -0x800;  // 12 bit signed weights and thresholds
+  static const int32_t kMaxHwValue = 0x7FF;
+
+  struct WeightSet {
+    int32_t w[kNWeights];
+  };
+
+  typedef std::vector<int32_t, EcalAlignedAllocator<int32_t> > Column;
+
+  EcalSRSettingsTable(const EcalSRSettings& settings, const EcalMappingElectronics& mapping);
+
+  int32_t firstSample(uint32_t denseIndex) const { return firstSample_[index(denseIndex)]; }
+  int32_t weightSet(uint32_t denseIndex) const { return weightSet_[index(denseIndex)]; }
+  int32_t thresholdLow(uint32_t denseIndex) const { return thresholdLow_[index(denseIndex)]; }
+  int32_t thresholdHigh(uint32_t denseIndex) const { return thresholdHigh_[index(denseIndex)]; }
+  bool symmetric(uint32_t denseIndex) const { return symmetric_[index(denseIndex)] != 0; }
+
+  /// DCC id (1-54) of a crystal, 0 if unknown
+  int dcc(uint32_t denseIndex) const { return dcc_[index(denseIndex)]; }
+
+  const int32_t* weights(int32_t slot) const { return weightSets_[slot].w; }
+  const std::vector<WeightSet>& weightSets() const { return weightSets_; }
+
+  /// whole columns, kSizeForDenseIndexing + 1 entries
+  const Column& firstSamples() const { return firstSample_; }
+  const Column& weightSetSlots() const { return weightSet_; }
+  const Column& thresholdsLow() const { return thresholdLow_; }
+  const Column& thresholdsHigh() const { return thresholdHigh_; }
+  const Column& symmetricMasks() const { return symmetric_; }
+
+  /// conversions to the hardware representation
+  static int32_t hwWeight(float w);
+  static int32_t hwThreshold(float thresholdGeV, float adcToGeV);
+
+ private:
+  static uint32_t index(uint32_t denseIndex) {
+    return denseIndex < EcalDenseIndex::kSizeForDenseIndexing ? denseIndex : EcalDenseIndex::kSizeForDenseIndexing;
+  }
+
+  std::vector<WeightSet> weightSets_;
+  Column firstSample_;
+  Column weightSet_;
+  Column thresholdLow_;
+  Column thresholdHigh_;
+  Column symmetric_;
+  std::vector<uint8_t> dcc_;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef CondFormats_EcalObjects_EcalSRZeroSuppressor_H
+#define CondFormats_EcalObjects_EcalSRZeroSuppressor_H
+/**
+ * Batch emulation of the DCC zero suppression, bit exact with the
+ * hardware, on the settings resolved by EcalSRSettingsTable.
+ *
+ * For a frame of raw samples (ADC bits 0-11, gain id bits 12-13, as in
+ * EcalMGPASample) of a crystal the DCC FIR filter computes
+ *
+ *   acc = sum_k w[k] * adc[firstSample + k]     (k < kNWeights)
+ *   acc = |acc|                                 (symmetric ZS only)
+ *   acc = ((acc + (1 << 30)) >> 8) - (1 << 22)  (drops 8 bits, rounding down)
+ *
+ * and the frame is kept if acc >= threshold or if a sample of the window is
+ * not at gain 12, as in EcalSelectiveReadoutSuppressor::accept(). The
+ * threshold is the low interest or the high interest one according to the
+ * SR flag of the frame; INT_MAX keeps only the frames with a gain switch,
+ * INT_MIN keeps all of them. Samples of the window beyond the frame are
+ * not used, as in the emulator.
+ *
+ * run() filters frames of many crystals at once, one frame per SIMD lane
+ * (see EcalSimd.h), and sets bit i of the keep mask for a kept frame i:
+ *
+ *   EcalSRZeroSuppressor zs(table);
+ *   std::vector<uint64_t> keep((nFrames + 63) / 64);
+ *   zs.run(nFrames, 10, denseIndices, samples, highInterest, &keep[0]);
+ *
+ * The table is referenced, not copied: it must outlive the suppressor.
+ * Transient object.
+ **/
+
+#include <cstddef>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalSRSettingsTable.h"
+
+class EcalSRZeroSuppressor {
+ public:
+  explicit EcalSRZeroSuppressor(const EcalSRSettingsTable& table) : table_(&table) {}
+
+  /// FIR output of a frame, before the threshold
+  int32_t filter(uint32_t denseIndex, const uint16_t* frame, unsigned int nSamples) const;
+
+  /// true if the frame is kept
+  bool accept(uint32_t denseIndex, const uint16_t* frame, unsigned int nSamples, bool highInterest) const;
+
+  /// nFrames frames of nSamples raw samples; frame i belongs to the crystal of dense index
+  /// denseIndices[i] and uses the high interest threshold if highInterest[i] != 0.
+  /// keep must hold (nFrames + 63) / 64 words; bits of frames beyond nFrames are cleared
+  void run(size_t nFrames, unsigned int nSamples, const uint32_t* denseIndices, const uint16_t* samples,
+           const uint8_t* highInterest, uint64_t* keep) const;
+
+ private:
+  const EcalSRSettingsTable* table_;
+};
+
+#endif
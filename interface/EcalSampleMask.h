@@ -23,12 +23,12 @@ class EcalSampleMask {
     ~EcalSampleMask();
 
     void setEcalSampleMaskRecordEB( const unsigned int mask ) { sampleMaskEB_ = mask; }
-    void setEcalSampleMaskRecordEE( const unsigned int mask ) { sampleMaskEB_ = mask; }
+    void setEcalSampleMaskRecordEE( const unsigned int mask ) { sampleMaskEE_ = mask; }
     void setEcalSampleMaskRecordEB( const std::vector<unsigned int> & ebmask );
     void setEcalSampleMaskRecordEE( const std::vector<unsigned int> & eemask );
     
-    float getEcalSampleMaskRecordEB() const { return sampleMaskEB_; }
-    float getEcalSampleMaskRecordEE() const { return sampleMaskEE_; }
+    unsigned int getEcalSampleMaskRecordEB() const { return sampleMaskEB_; }
+    unsigned int getEcalSampleMaskRecordEE() const { return sampleMaskEE_; }
     void print(std::ostream& s) const {
       s << "EcalSampleMask: EB " << sampleMaskEB_ << "; EE " << sampleMaskEE_ ;
     }
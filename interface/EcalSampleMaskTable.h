@@ -0,0 +1,62 @@
+#ifndef CondFormats_EcalObjects_EcalSampleMaskTable_H
+#define CondFormats_EcalObjects_EcalSampleMaskTable_H
+/**
+ * Unpacked form of the EcalSampleMask bit words, for the inner loops of
+ * the amplitude reconstruction.
+ *
+ * For EB and EE the table holds, computed once:
+ *  - the number and the (increasing) indices of the active samples, so that
+ *    a fit can loop on the active samples only;
+ *  - a blend mask (-1 active, 0 masked) and a 0/1 weight per sample, so that
+ *    a vectorized loop over all the samples can zero the masked ones
+ *    without branches.
+ * The arrays are padded to kPaddedSamples entries (masked). With gcc and
+ * clang each Samples starts a cache line (64 bytes), except in a table
+ * allocated with new before C++17, which only guarantees 16 bytes.
+ *
+ *   EcalSampleMaskTable masks(sampleMask);
+ *   const EcalSampleMaskTable::Samples & s = masks.get(detId);
+ *   for (unsigned int i = 0; i < s.nActive; ++i) use(frame[s.active[i]]);
+ *
+ * Sample 0 is the first sample read out, i.e. the most significant bit of
+ * the EcalSampleMask words. Transient object.
+ **/
+
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalSampleMask.h"
+
+class EcalSampleMaskTable {
+ public:
+  static const unsigned int kPaddedSamples = 16;
+
+  struct Samples {
+    int32_t active[kPaddedSamples];  // indices of the active samples, first nActive entries
+    int32_t blend[kPaddedSamples];   // -1 for active samples, 0 otherwise
+    float weight[kPaddedSamples];    // 1 for active samples, 0 otherwise
+    unsigned int nActive;
+    unsigned int mask;               // bit word as in EcalSampleMask
+  }
+#if defined(__GNUC__) && !defined(__GCCXML__)
+  __attribute__((aligned(64)))
+#endif
+  ;
+
+  explicit EcalSampleMaskTable(const EcalSampleMask& sampleMask);
+
+  const Samples& barrel() const { return samples_[0]; }
+  const Samples& endcap() const { return samples_[1]; }
+
+  /// samples of EB for any non-endcap id
+  const Samples& get(const DetId& id) const { return samples_[id.subdetId() == EcalEndcap]; }
+
+  bool useSample(int sampleId, const DetId& id) const { return get(id).blend[sampleId] != 0; }
+
+  /// unpack a mask word
+  static void unpack(unsigned int mask, Samples& samples);
+
+ private:
+  Samples samples_[2];
+};
+
+#endif
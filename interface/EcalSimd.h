@@ -0,0 +1,164 @@
+#ifndef CondFormats_EcalObjects_EcalSimd_H
+#define CondFormats_EcalObjects_EcalSimd_H
+/**
+ * Minimal SIMD layer for the batch kernels of this package.
+ *
+ * With gcc/clang the vectors are built on the compiler vector extensions:
+ * the width follows the target instruction set of the translation unit
+ * (16 lanes with AVX-512, 8 with AVX2, 4 otherwise). Other compilers get
+ * one-lane "vectors", i.e. the scalar fallback.
+ *
+ * The baseline flags of the release only give SSE. A kernel can also be
+ * built for a wider instruction set in a translation unit of its own,
+ * compiled for it (#pragma GCC target before any include, which does not
+ * define __AVX2__ and the like in C++: ECAL_SIMD_LANES then gives the
+ * width), and selected at run time with runtimeLanes(). All the helpers here are always
+ * inlined, even without optimization, and so must be the functions of
+ * such a kernel: then neither a wide vector crosses a call, nor a copy of
+ * a helper compiled for the wider target is shared with the other
+ * translation units.
+ *
+ * The math functions are written once for both the vector and the scalar
+ * types, so that the tail loops of the kernels give the same results as the
+ * vectorized body.
+ *
+ * Transient helper: not to be included by persistent classes.
+ **/
+
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+#if defined(__GNUC__) && !defined(__GCCXML__)
+#define ECAL_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define ECAL_SIMD_INLINE inline
+#endif
+
+namespace ecalsimd {
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__GCCXML__) && !defined(__CINT__)
+#define ECAL_SIMD_VECTOR_EXTENSIONS 1
+#if defined(ECAL_SIMD_LANES)
+  static const int kLanes = ECAL_SIMD_LANES;
+#elif defined(__AVX512F__)
+  static const int kLanes = 16;
+#elif defined(__AVX2__)
+  static const int kLanes = 8;
+#else
+  static const int kLanes = 4;
+#endif
+  typedef float vfloat __attribute__((vector_size(kLanes * sizeof(float))));
+  typedef int32_t vint __attribute__((vector_size(kLanes * sizeof(int32_t))));
+  /// doubles in a vector of the same size, for the sums that need double precision
+  static const int kDoubleLanes = kLanes / 2;
+  typedef double vdouble __attribute__((vector_size(kDoubleLanes * sizeof(double))));
+#else
+  static const int kLanes = 1;
+  static const int kDoubleLanes = 1;
+  typedef float vfloat;
+  typedef int32_t vint;
+  typedef double vdouble;
+#endif
+
+  /// widest vectors supported by the running cpu, at least kLanes
+  ECAL_SIMD_INLINE int runtimeLanes() {
+#if defined(ECAL_SIMD_VECTOR_EXTENSIONS) && (defined(__x86_64__) || defined(__i386__))
+    if (kLanes < 16 && __builtin_cpu_supports("avx512f")) return 16;
+    if (kLanes < 8 && __builtin_cpu_supports("avx2")) return 8;
+#endif
+    return kLanes;
+  }
+
+  // ---- loads, stores and conversions: vector and scalar overloads ----
+
+  template <typename V, typename S>
+  ECAL_SIMD_INLINE V load(const S* p) { V v; std::memcpy(&v, p, sizeof(V)); return v; }
+
+  template <typename V, typename S>
+  ECAL_SIMD_INLINE void store(S* p, const V& v) { std::memcpy(p, &v, sizeof(V)); }
+
+  template <typename V, typename S>
+  ECAL_SIMD_INLINE V splat(S x) { V v; S* s = reinterpret_cast<S*>(&v); for (size_t i = 0; i < sizeof(V) / sizeof(S); ++i) s[i] = x; return v; }
+
+  ECAL_SIMD_INLINE int32_t asInt(float x) { int32_t i; std::memcpy(&i, &x, sizeof(i)); return i; }
+  ECAL_SIMD_INLINE float asFloat(int32_t i) { float x; std::memcpy(&x, &i, sizeof(x)); return x; }
+  ECAL_SIMD_INLINE float toFloat(int32_t i) { return float(i); }
+  ECAL_SIMD_INLINE int32_t toInt(float x) { return int32_t(x); }
+  ECAL_SIMD_INLINE int32_t mask(bool b) { return -int32_t(b); }
+  ECAL_SIMD_INLINE int32_t lt(float a, float b) { return mask(a < b); }
+  ECAL_SIMD_INLINE int32_t gt(float a, float b) { return mask(a > b); }
+  ECAL_SIMD_INLINE int32_t eq(int32_t a, int32_t b) { return mask(a == b); }
+  ECAL_SIMD_INLINE int32_t lt(int32_t a, int32_t b) { return mask(a < b); }
+  ECAL_SIMD_INLINE int32_t gt(int32_t a, int32_t b) { return mask(a > b); }
+
+#ifdef ECAL_SIMD_VECTOR_EXTENSIONS
+  ECAL_SIMD_INLINE vint asInt(vfloat x) { return (vint)x; }
+  ECAL_SIMD_INLINE vfloat asFloat(vint i) { return (vfloat)i; }
+  ECAL_SIMD_INLINE vfloat toFloat(vint i) { return __builtin_convertvector(i, vfloat); }
+  ECAL_SIMD_INLINE vint toInt(vfloat x) { return __builtin_convertvector(x, vint); }
+  ECAL_SIMD_INLINE vint lt(vfloat a, vfloat b) { return a < b; }
+  ECAL_SIMD_INLINE vint gt(vfloat a, vfloat b) { return a > b; }
+  ECAL_SIMD_INLINE vint eq(vint a, vint b) { return a == b; }
+  ECAL_SIMD_INLINE vint lt(vint a, vint b) { return a < b; }
+  ECAL_SIMD_INLINE vint gt(vint a, vint b) { return a > b; }
+#endif
+
+  /// m ? a : b lane by lane, m being 0 or -1
+  template <typename VF, typename VI>
+  ECAL_SIMD_INLINE VF select(VI m, VF a, VF b) { return asFloat((asInt(a) & m) | (asInt(b) & ~m)); }
+
+  template <typename VI>
+  ECAL_SIMD_INLINE VI selectInt(VI m, VI a, VI b) { return (a & m) | (b & ~m); }
+
+  // ---- math, Cephes single precision polynomials (relative error ~1e-7) ----
+
+  /// natural logarithm, for x > 0 and finite
+  template <typename VF, typename VI>
+  ECAL_SIMD_INLINE VF log(VF x) {
+    const VI ix = asInt(x);
+    VI e = ((ix >> 23) & 0xff) - 126;
+    VF m = asFloat((ix & 0x007fffff) | 0x3f000000);  // x = m * 2^e, m in [0.5, 1)
+    const VI small = lt(m, splat<VF>(0.707106781186547524f));
+    e = e + small;  // small is -1 where true
+    m = m + select(small, m, splat<VF>(0.f)) - 1.f;
+    const VF fe = toFloat(e);
+    const VF z = m * m;
+    VF y = 7.0376836292E-2f * m - 1.1514610310E-1f;
+    y = y * m + 1.1676998740E-1f;
+    y = y * m - 1.2420140846E-1f;
+    y = y * m + 1.4249322787E-1f;
+    y = y * m - 1.6668057665E-1f;
+    y = y * m + 2.0000714765E-1f;
+    y = y * m - 2.4999993993E-1f;
+    y = y * m + 3.3333331174E-1f;
+    y = y * m * z;
+    y = y - 2.12194440e-4f * fe;
+    y = y - 0.5f * z;
+    return m + y + 0.693359375f * fe;
+  }
+
+  /// exponential, argument clamped to [-87, 88]
+  template <typename VF, typename VI>
+  ECAL_SIMD_INLINE VF exp(VF x) {
+    x = select(gt(x, splat<VF>(88.f)), splat<VF>(88.f), x);
+    x = select(lt(x, splat<VF>(-87.f)), splat<VF>(-87.f), x);
+    VF fx = x * 1.44269504088896341f + 0.5f;
+    VI n = toInt(fx);
+    VF t = toFloat(n);
+    const VI over = gt(t, fx);  // floor for negative arguments
+    n = n + over;
+    t = toFloat(n);
+    x = x - t * 0.693359375f + t * 2.12194440e-4f;
+    const VF z = x * x;
+    VF y = 1.9875691500E-4f * x + 1.3981999507E-3f;
+    y = y * x + 8.3334519073E-3f;
+    y = y * x + 4.1665795894E-2f;
+    y = y * x + 1.6666665459E-1f;
+    y = y * x + 5.0000001201E-1f;
+    y = y * z + x + 1.f;
+    return y * asFloat((n + 127) << 23);
+  }
+
+}
+
+#endif
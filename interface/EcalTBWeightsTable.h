@@ -0,0 +1,75 @@
+#ifndef CondFormats_EcalObjects_EcalTBWeightsTable_H
+#define CondFormats_EcalObjects_EcalTBWeightsTable_H
+/**
+ * Dense lookup table of the weight sets of EcalTBWeights.
+ *
+ * The weight sets are copied once in a contiguous vector and addressed by
+ * a 2-D (group index, TDC bin) table: group indices number the distinct
+ * EcalXtalGroupIds in increasing order, TDC bins run from the smallest to
+ * the largest TDC id of the payload. Lookups are two array reads instead
+ * of a walk of the std::map keyed on (group, TDC).
+ *
+ * When the EcalWeightXtalGroups payload is given, the group index of every
+ * crystal is resolved at construction too, and forCrystal() goes from a
+ * crystal raw id to its weight set in one step:
+ *
+ *   EcalTBWeightsTable table(tbWeights, &xtalGroups);
+ *   const EcalWeightSet * ws = table.forCrystal(detId.rawId(), tdcId);
+ *   if (ws) ... // null when no weights exist for the crystal and TDC id
+ *
+ * Transient object, independent of the payloads once built.
+ **/
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalTBWeights.h"
+#include "CondFormats/EcalObjects/interface/EcalWeightXtalGroups.h"
+
+class EcalTBWeightsTable {
+ public:
+  typedef EcalTBWeights::EcalTDCId EcalTDCId;
+
+  /// larger spans of TDC ids are refused by the constructor
+  static const uint32_t kMaxTDCBins = 1 << 16;
+
+  explicit EcalTBWeightsTable(const EcalTBWeights& weights, const EcalWeightXtalGroups* xtalGroups = 0);
+
+  /// index of groupId in the table, -1 if the payload has no weights for it
+  int groupIndex(const EcalXtalGroupId& groupId) const;
+
+  /// weight set of (group index, TDC id), null if there is none
+  const EcalWeightSet* get(int groupIndex, EcalTDCId tdcId) const {
+    const uint32_t bin = uint32_t(tdcId) - uint32_t(firstTDC_);
+    if (uint32_t(groupIndex) >= groupIds_.size() || bin >= nTDCBins_) return 0;
+    const int32_t s = table_[groupIndex * nTDCBins_ + bin];
+    return s < 0 ? 0 : &sets_[s];
+  }
+
+  const EcalWeightSet* get(const EcalXtalGroupId& groupId, EcalTDCId tdcId) const {
+    return get(groupIndex(groupId), tdcId);
+  }
+
+  /// weight set of the group of the crystal, null without the EcalWeightXtalGroups payload
+  const EcalWeightSet* forCrystal(uint32_t rawId, EcalTDCId tdcId) const {
+    const uint32_t i = EcalDenseIndex::fromRawId(rawId);
+    return i < xtalGroup_.size() ? get(xtalGroup_[i], tdcId) : 0;
+  }
+
+  size_t nGroups() const { return groupIds_.size(); }
+  size_t nTDCBins() const { return nTDCBins_; }
+  EcalTDCId firstTDC() const { return firstTDC_; }
+
+  /// group id of a group index
+  const EcalXtalGroupId& groupId(int groupIndex) const { return groupIds_[groupIndex]; }
+
+ private:
+  std::vector<EcalXtalGroupId> groupIds_;  // sorted
+  EcalTDCId firstTDC_;
+  uint32_t nTDCBins_;
+  std::vector<EcalWeightSet> sets_;
+  std::vector<int32_t> table_;      // index in sets_, -1 if none
+  std::vector<int32_t> xtalGroup_;  // group index by crystal dense index
+};
+
+#endif
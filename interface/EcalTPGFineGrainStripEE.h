@@ -4,6 +4,8 @@
 #include <map>
 #include <boost/cstdint.hpp>
 
+#include "CondFormats/EcalObjects/interface/EcalFlatMap.h"
+
 class EcalTPGFineGrainStripEE 
 {
  public:
@@ -17,10 +19,14 @@ class EcalTPGFineGrainStripEE
   };
 
   const std::map<uint32_t, Item> & getMap() const { return map_; }
+  // same content as getMap(), as a flat sorted array with fast lookup;
+  // built once, setValue() throws afterwards
+  const EcalFlatMap<uint32_t, Item> & getFlatMap() const { return flat_.get(map_); }
   void  setValue(const uint32_t & id, const Item & value) ;
 
  private:
   std::map<uint32_t, Item> map_ ;
+  EcalFlatMapCache<uint32_t, Item> flat_ ;  // transient
 
 };
 
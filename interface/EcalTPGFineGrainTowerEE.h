@@ -4,6 +4,8 @@
 #include <map>
 #include <boost/cstdint.hpp>
 
+#include "CondFormats/EcalObjects/interface/EcalFlatMap.h"
+
 class EcalTPGFineGrainTowerEE 
 {
  public:
@@ -12,10 +14,14 @@ class EcalTPGFineGrainTowerEE
 
   // map<stripId, lut>
   const std::map<uint32_t, uint32_t> & getMap() const { return map_; }
+  // same content as getMap(), as a flat sorted array with fast lookup;
+  // built once, setValue() throws afterwards
+  const EcalFlatMap<uint32_t, uint32_t> & getFlatMap() const { return flat_.get(map_); }
   void  setValue(const uint32_t & id, const uint32_t & lut) ;
 
  private:
   std::map<uint32_t, uint32_t> map_ ;
+  EcalFlatMapCache<uint32_t, uint32_t> flat_ ;  // transient
 
 };
 
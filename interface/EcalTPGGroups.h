@@ -4,6 +4,8 @@
 #include <map>
 #include <boost/cstdint.hpp>
 
+#include "CondFormats/EcalObjects/interface/EcalFlatMap.h"
+
 /*
 this class is used to define groups which associate a rawId to an objectId where:
 - rawId (simple integer) refers to a crystal (i.e EBDetId.rawId()), a (pseudo)strip or a tower
@@ -24,10 +26,14 @@ class EcalTPGGroups
   ~EcalTPGGroups() ;
 
   const EcalTPGGroupsMap & getMap() const { return map_; }
+  // same content as getMap(), as a flat sorted array with fast lookup;
+  // built once, setValue() throws afterwards
+  const EcalFlatMap<uint32_t, uint32_t> & getFlatMap() const { return flat_.get(map_); }
   void  setValue(const uint32_t & rawId, const   uint32_t & ObjectId) ;
 
  protected:
   EcalTPGGroupsMap map_ ;
+  EcalFlatMapCache<uint32_t, uint32_t> flat_ ;  // transient
 
 };
 
@@ -0,0 +1,74 @@
+#ifndef CondFormats_EcalObjects_EcalTPGLinearizer_H
+#define CondFormats_EcalObjects_EcalTPGLinearizer_H
+/**
+ * Fused TPG linearization table and batch kernel.
+ *
+ * For each crystal and gain the TPG pedestal, multiplier and shift of
+ * EcalTPGPedestals and EcalTPGLinearizationConst are packed, at the
+ * hardware widths, in one 32 bit word:
+ *   bits  0-11  pedestal   (12 bits, ADC range)
+ *   bits 12-19  multiplier (8 bits)
+ *   bits 20-23  shift      (4 bits, shiftOffset included)
+ * The four words of a crystal are indexed by the gain id of the sample
+ * (1: x12, 2: x6, 3: x1; 0, a saturated sample, uses pedestal 0,
+ * multiplier 0xFF and the x1 shift, as the FENIX) and sit in 16
+ * consecutive bytes, in dense index order (EcalDenseIndex).
+ *
+ * A raw sample (ADC bits 0-11, gain id bits 12-13, as in EcalMGPASample)
+ * is linearized as
+ *
+ *   max(0, min(0x3FFFF, ((adc - pedestal) * multiplier) >> shift))
+ *
+ * linearize() runs this over whole frames with integer SIMD arithmetic
+ * (see EcalSimd.h). shiftOffset is added to the shifts of the payload when
+ * the table is built: the FENIX shifts by the payload shift + 2
+ * (EcalFenixLinearizer), which the default kFenixShiftOffset reproduces;
+ * 0 gives the bare payload shifts.
+ *
+ * Transient object: the payloads are not needed after construction.
+ **/
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalAlignedAllocator.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGLinearizationConst.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGPedestals.h"
+
+class EcalTPGLinearizer {
+ public:
+  static const int32_t kMaxOutput = 0x3FFFF;
+  static const uint32_t kPedestalBits = 12;
+  static const uint32_t kMultiplierBits = 8;
+  static const uint32_t kShiftBits = 4;
+  static const uint32_t kFenixShiftOffset = 2;
+  static const uint32_t kSaturatedMultiplier = 0xFF;
+
+  /// throws if a constant does not fit the hardware width
+  EcalTPGLinearizer(const EcalTPGPedestals& pedestals, const EcalTPGLinearizationConst& linearization,
+                    uint32_t shiftOffset = kFenixShiftOffset);
+
+  static uint32_t pack(uint32_t pedestal, uint32_t multiplier, uint32_t shift) {
+    return pedestal | (multiplier << kPedestalBits) | (shift << (kPedestalBits + kMultiplierBits));
+  }
+
+  /// packed constants of a crystal for a gain id (0-3); crystals out of range give 0
+  uint32_t word(uint32_t denseIndex, int gainId) const { return table_[entry(denseIndex, gainId)]; }
+
+  /// linearized value of one raw sample of a crystal
+  int32_t linearize(uint32_t denseIndex, uint16_t sample) const;
+
+  /// nFrames frames of nSamples raw samples each; frame i belongs to the crystal of dense index denseIndices[i]
+  void linearize(size_t nFrames, unsigned int nSamples, const uint32_t* denseIndices,
+                 const uint16_t* samples, int32_t* out) const;
+
+ private:
+  static size_t entry(uint32_t denseIndex, int gainId) {
+    const uint32_t d = denseIndex < EcalDenseIndex::kSizeForDenseIndexing ? denseIndex : EcalDenseIndex::kSizeForDenseIndexing;
+    return 4 * size_t(d) + (gainId & 3);
+  }
+
+  std::vector<uint32_t, EcalAlignedAllocator<uint32_t> > table_;
+};
+
+#endif
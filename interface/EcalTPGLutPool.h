@@ -0,0 +1,109 @@
+#ifndef CondFormats_EcalObjects_EcalTPGLutPool_H
+#define CondFormats_EcalObjects_EcalTPGLutPool_H
+/**
+ * Deduplicated, compact store of the TPG look-up tables.
+ *
+ * The LUT ids of an EcalTPGLutIdMap often carry identical tables. The pool
+ * keeps each distinct table once, found through a hash of its content, and
+ * maps every LUT id to the slot of its table:
+ *
+ *   EcalTPGLutPool pool(lutIdMap);
+ *   size_t slot = pool.slot(lutId);          // once per tower/crystal
+ *   unsigned int word = pool.value(slot, adc);
+ *
+ * Tables are stored compactly: the saturated tail (the last entries, all
+ * equal to the value of entry 1023) is dropped, and the remaining entries
+ * are kept on 16 bits whenever they all fit, on 32 bits otherwise. The
+ * lookup is exact for any table.
+ *
+ * Tables are reference counted by LUT id: a table no longer used after
+ * setLut() frees its slot, reused by the next new table, and the contents
+ * are compacted once the freed entries outnumber the used ones. Slots of
+ * the tables in use never change.
+ *
+ * Any slot at or above size() (an unknown LUT id) reads an all-zero table.
+ *
+ * Transient object: the persistent EcalTPGLutIdMap is left unchanged.
+ **/
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalTPGLut.h"
+
+class EcalTPGLutIdMap;
+
+class EcalTPGLutPool {
+ public:
+  static const unsigned int kLutSize = 1024;
+
+  EcalTPGLutPool();
+  explicit EcalTPGLutPool(const EcalTPGLutIdMap& lutMap);
+
+  /// associate lutId to the table, replacing its previous table if any; returns the slot of the table
+  size_t setLut(uint32_t lutId, const unsigned int* lut);
+
+  /// slot of the table of lutId, size() if lutId is unknown
+  size_t slot(uint32_t lutId) const;
+
+  /// entry adc (0 to kLutSize - 1) of the table in slot, 0 if slot >= size()
+  unsigned int value(size_t slot, unsigned int adc) const {
+    const Table& t = table(slot);
+    if (adc >= t.length) return t.tail;
+    return t.wide ? wide_[t.offset + adc] : narrow_[t.offset + adc];
+  }
+
+  /// copy the full table in slot to out[kLutSize]
+  void expand(size_t slot, unsigned int* out) const;
+
+  /// the table in slot as a plain EcalTPGLut
+  EcalTPGLut lut(size_t slot) const;
+
+  /// number of slots, in use or free; slot(lutId) < size() for known ids
+  size_t size() const { return tables_.size() - 1; }
+
+  /// number of distinct tables in use
+  size_t nTables() const { return size() - freeSlots_.size(); }
+
+  /// number of LUT ids
+  size_t nIds() const { return ids_.size(); }
+
+  /// memory used by the table contents, freed entries not compacted yet included, in bytes
+  size_t memoryBytes() const { return narrow_.size() * sizeof(uint16_t) + wide_.size() * sizeof(uint32_t); }
+
+  static uint64_t hash(const unsigned int* lut);
+
+ private:
+  struct Table {
+    uint64_t hash;
+    uint32_t offset;  // first entry in narrow_ or wide_
+    uint32_t length;  // number of stored entries, the following ones are equal to tail
+    uint32_t tail;
+    uint32_t refs;    // number of LUT ids using the table, 0 for a free slot
+    bool wide;
+  };
+
+  // the table in slot, the sentinel for slot >= size()
+  const Table& table(size_t slot) const { return tables_[std::min(slot, size())]; }
+
+  // slot of the table, added to the pool if no identical table is there yet
+  size_t add(const unsigned int* lut);
+
+  // one LUT id less for the table in slot
+  void release(size_t slot);
+
+  // drop the entries of the freed tables
+  void compact();
+
+  std::vector<Table> tables_;  // by slot, plus a last empty sentinel table
+  std::vector<uint16_t> narrow_;
+  std::vector<uint32_t> wide_;
+  size_t freedEntries_;  // in narrow_ and wide_
+  std::vector<uint32_t> freeSlots_;
+  std::multimap<uint64_t, uint32_t> byHash_;
+  std::map<uint32_t, uint32_t> ids_;
+};
+
+#endif
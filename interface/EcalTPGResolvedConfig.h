@@ -0,0 +1,100 @@
+#ifndef CondFormats_EcalObjects_EcalTPGResolvedConfig_H
+#define CondFormats_EcalObjects_EcalTPGResolvedConfig_H
+/**
+ * TPG configuration with the group indirections resolved.
+ *
+ * The TPG parameters are reached through two maps each: tower -> LUT id ->
+ * EcalTPGLut, tower -> fine grain id -> EcalTPGFineGrainConstEB and
+ * strip -> weight id -> EcalTPGWeights. This object, built once per IOV,
+ * stores the distinct parameters once (EcalTPGLutPool for the LUTs, plain
+ * deduplicated vectors for weights and fine grain constants) and, for
+ * each tower and strip, the slots of its parameters in these pools.
+ *
+ * Towers are numbered by towerIndex(), computed from the raw id bits: EB
+ * trigger towers by their EcalTowerLattice index (eta major, see
+ * EcalTowerStatusLattice.h), EE trigger towers after them by (side, |ieta|,
+ * iphi). The LUT and fine grain slots of a tower are read with a single
+ * load:
+ *
+ *   EcalTPGResolvedConfig tpg(lutGroup, lutMap, fgGroup, fgMap, weightGroup, weightMap);
+ *   const EcalTPGResolvedConfig::Tower & t = tpg.tower(tpg.towerIndex(ttId.rawId()));
+ *   unsigned int et = t.lut != EcalTPGResolvedConfig::kNone ? tpg.lutPool().value(t.lut, adc) : 0;
+ *   const EcalTPGFineGrainConstEB * fg = tpg.fineGrain(t.fineGrain);
+ *
+ * Strips are numbered by stripIndex(), by (TCC, trigger tower, pseudo strip)
+ * of their id (an EcalTriggerElectronicsId raw id with the channel bits
+ * cleared), and their weight slots are read from a dense array. Slots are
+ * kNone when the group or the parameter id is missing; the corresponding
+ * pointers are then null, and the LUT pool reads an all-zero table.
+ * Towers and strips of the groups whose ids do not decode as above are
+ * ignored.
+ *
+ * Transient object: the payloads are not needed after construction.
+ **/
+
+#include <algorithm>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalMappingElectronicsIndex.h"
+#include "CondFormats/EcalObjects/interface/EcalTowerStatusLattice.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGLutPool.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGLutGroup.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGLutIdMap.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGFineGrainEBGroup.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGFineGrainEBIdMap.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGWeightGroup.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGWeightIdMap.h"
+
+class EcalTPGResolvedConfig {
+ public:
+  static const uint32_t kNone = 0xffffffff;
+  static const uint32_t kEETowerEtaMin = 18;  // |ieta| of the EE trigger towers
+  static const uint32_t kEETowerEta = 11;
+  static const uint32_t kEETowerPhi = 72;
+  static const uint32_t kTowers = EcalTowerLattice::kEBSize + 2 * kEETowerEta * kEETowerPhi;
+  static const uint32_t kStrips = EcalMappingElectronicsIndex::kTriggerSize * EcalMappingElectronicsIndex::kStrips;
+
+  struct Tower {
+    uint32_t lut;        // slot in lutPool()
+    uint32_t fineGrain;  // slot for fineGrain()
+  };
+
+  EcalTPGResolvedConfig(const EcalTPGLutGroup& lutGroup, const EcalTPGLutIdMap& luts,
+                        const EcalTPGFineGrainEBGroup& fineGrainGroup, const EcalTPGFineGrainEBIdMap& fineGrains,
+                        const EcalTPGWeightGroup& weightGroup, const EcalTPGWeightIdMap& weights);
+
+  /// index of a trigger tower raw id, kNone if it is not an EB or EE trigger tower
+  static uint32_t towerIndex(uint32_t ttRawId);
+
+  /// index of a strip id, kNone if it is not a strip of the trigger electronics
+  static uint32_t stripIndex(uint32_t stripId);
+
+  /// slots of the parameters of a tower, by tower index
+  const Tower& tower(uint32_t towerIndex) const { return towers_[towerIndex < towers_.size() ? towerIndex : towers_.size() - 1]; }
+
+  size_t nTowers() const { return kTowers; }
+
+  const EcalTPGLutPool& lutPool() const { return luts_; }
+
+  const EcalTPGFineGrainConstEB* fineGrain(uint32_t slot) const { return slot < fineGrains_.size() ? &fineGrains_[slot] : 0; }
+
+  /// weights of a strip, null if unknown
+  const EcalTPGWeights* weights(uint32_t stripId) const {
+    const uint32_t slot = stripWeights_[std::min(stripIndex(stripId), kStrips)];
+    return slot < weights_.size() ? &weights_[slot] : 0;
+  }
+
+  /// number of distinct weight sets and fine grain constants
+  size_t nWeights() const { return weights_.size(); }
+  size_t nFineGrains() const { return fineGrains_.size(); }
+
+ private:
+  EcalTPGLutPool luts_;
+  std::vector<EcalTPGWeights> weights_;
+  std::vector<EcalTPGFineGrainConstEB> fineGrains_;
+  std::vector<Tower> towers_;          // by tower index, plus a last {kNone, kNone} entry
+  std::vector<uint32_t> stripWeights_; // slot in weights_ by strip index, plus a last kNone entry
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef CondFormats_EcalObjects_EcalTemperatureSeries_H
+#define CondFormats_EcalObjects_EcalTemperatureSeries_H
+/**
+ * Time series of temperature snapshots (EcalDCUTemperatures or
+ * EcalPTMTemperatures payloads), stored by column.
+ *
+ * The sensor ids are stored once, sorted, and fixed by the first snapshot
+ * (or given to the constructor); each snapshot is then a contiguous,
+ * aligned row of floats, one per sensor in id order, at its time. Sensors
+ * missing from a snapshot are NaN in it; sensors unknown to the series
+ * throw. Snapshots are added in increasing time order.
+ *
+ * At time t the temperatures are linearly interpolated between the two
+ * snapshots around t (found by binary search, O(log T)); before the first
+ * snapshot and after the last one they are those of the snapshot. The
+ * evaluation over all the sensors is vectorized (see EcalSimd.h):
+ *
+ *   EcalTemperatureSeries dcu;
+ *   for (...) dcu.add(iovStart, dcuTemperatures);
+ *   std::vector<float> temps;
+ *   dcu.interpolate(t, temps);      // temps[i] is the sensor dcu.sensorIds()[i]
+ *   float temp = dcu.value(dcuId, t);
+ *
+ * Transient object. The const methods can be called concurrently.
+ **/
+
+#include <map>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalAlignedAllocator.h"
+#include "CondFormats/EcalObjects/interface/EcalDCUTemperatures.h"
+#include "CondFormats/EcalObjects/interface/EcalPTMTemperatures.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+
+class EcalTemperatureSeries {
+ public:
+  typedef std::vector<float, EcalAlignedAllocator<float> > FloatColumn;
+  static const size_t npos = size_t(-1);
+
+  EcalTemperatureSeries() : stride_(0) {}
+  /// a series of the given sensors, in any order
+  explicit EcalTemperatureSeries(const std::vector<uint32_t>& sensorIds);
+
+  /// add the snapshot of time t, later than the last one
+  void add(edm::Timestamp t, const std::map<uint32_t, float>& temperatures);
+  void add(edm::Timestamp t, const EcalDCUTemperatures& temperatures) { add(t, temperatures.getMap()); }
+  void add(edm::Timestamp t, const EcalPTMTemperatures& temperatures) { add(t, temperatures.getMap()); }
+
+  /// temperatures of all the sensors at time t, by sensor index; NaN if the series is empty
+  void interpolate(edm::Timestamp t, float* out) const;
+  void interpolate(edm::Timestamp t, std::vector<float>& out) const;
+
+  /// temperature of one sensor at time t, NaN for an unknown sensor or an empty series
+  float value(uint32_t sensorId, edm::Timestamp t) const;
+
+  /// index of a sensor in the rows, npos if unknown
+  size_t sensorIndex(uint32_t sensorId) const;
+
+  const std::vector<uint32_t>& sensorIds() const { return ids_; }
+  size_t nSensors() const { return ids_.size(); }
+  size_t nSnapshots() const { return times_.size(); }
+  edm::Timestamp time(size_t snapshot) const { return edm::Timestamp(times_[snapshot]); }
+
+  /// the temperatures of a snapshot, nSensors() values
+  const float* snapshot(size_t snapshot) const { return &values_[snapshot * stride_]; }
+
+ private:
+  void setSensors(std::vector<uint32_t> ids);
+
+  // snapshots i and i + 1 around t, and the weight of i + 1
+  void bracket(edm::Timestamp t, size_t& i, float& weight) const;
+
+  std::vector<uint32_t> ids_;
+  std::vector<edm::TimeValue_t> times_;
+  FloatColumn values_;  // one row of stride_ floats per snapshot
+  size_t stride_;       // nSensors() rounded up to whole SIMD vectors
+};
+
+#endif
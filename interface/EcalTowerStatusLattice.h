@@ -0,0 +1,114 @@
+#ifndef CondFormats_EcalObjects_EcalTowerStatusLattice_H
+#define CondFormats_EcalObjects_EcalTowerStatusLattice_H
+/**
+ * Tower status words on a direct (ieta, iphi) / (ix, iy, z) lattice.
+ *
+ * Contiguous storage of the status words of an EcalCondTowerObjectContainer
+ * (EcalDAQTowerStatus, EcalDCSTowerStatus, EcalDQMTowerStatus):
+ *   - EB trigger towers: 34 x 72, eta major: index (ieta + 17) * 72 + iphi - 1
+ *     for ieta < 0, (ieta + 16) * 72 + iphi - 1 for ieta > 0 (not the
+ *     EcalTrigTowerDetId::hashedIndex() order);
+ *   - EE supercrystals: 2 x 20 x 20 (z, ix, iy), positions outside of the
+ *     endcaps holding status 0.
+ * The status of the tower of every crystal is also expanded in a per
+ * crystal array (dense index order, see EcalDenseIndex), so that the
+ * crystal to tower status lookup is a single indexed load, without
+ * building the EcalTrigTowerDetId/EcalScDetId of the crystal:
+ *
+ *   EcalTowerStatusLattice<> daq(daqTowerStatus);
+ *   uint32_t s = daq.crystal(hit.id().rawId());
+ *   uint32_t t = daq.barrel(ieta, iphi);
+ *
+ * Code is the status word type, uint32_t by default so that it holds the
+ * EcalDQMStatusCode words; uint16_t halves the arrays for the DAQ and DCS
+ * codes. A Code narrower than the status words of the container does not
+ * compile. Ids which are not towers/crystals give status 0. Transient
+ * object.
+ **/
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalCondTowerObjectContainer.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+
+/// lattice geometry, shared by all the status word types
+class EcalTowerLattice {
+ public:
+  static const uint32_t kEBEta = 2 * EcalTrigTowerDetId::kEBTowersInEta;
+  static const uint32_t kEBPhi = 72;
+  static const uint32_t kEBSize = kEBEta * kEBPhi;
+  static const uint32_t kEESide = EcalScDetId::IX_MAX;
+  static const uint32_t kEESize = 2 * kEESide * kEESide;
+  static const uint32_t kSize = kEBSize + kEESize;  // index of the invalid slot
+
+  static uint32_t barrelIndex(int ieta, int iphi) {
+    const uint32_t eta = ieta + (ieta < 0 ? int(kEBEta / 2) : int(kEBEta / 2) - 1);
+    return eta < kEBEta && ieta != 0 && uint32_t(iphi - 1) < kEBPhi ? eta * kEBPhi + iphi - 1 : kSize;
+  }
+
+  static uint32_t endcapIndex(int ix, int iy, int zside) {
+    return uint32_t(ix - 1) < kEESide && uint32_t(iy - 1) < kEESide
+      ? kEBSize + ((zside > 0) * kEESide + ix - 1) * kEESide + iy - 1 : kSize;
+  }
+
+  /// lattice index of an EcalTrigTowerDetId (barrel) or EcalScDetId raw id
+  static uint32_t towerIndex(uint32_t rawId);
+
+  /// lattice index of the tower of a crystal, by crystal dense index
+  static uint32_t crystalTowerIndex(uint32_t denseIndex) { return crystalTowers()[denseIndex]; }
+
+  /// the lattice index of the tower of every crystal, plus kSize for invalid ids
+  static const std::vector<uint16_t>& crystalTowers();
+};
+
+template <typename Code = uint32_t>
+class EcalTowerStatusLattice : public EcalTowerLattice {
+ public:
+  template <typename T>
+  explicit EcalTowerStatusLattice(const EcalCondTowerObjectContainer<T>& status) :
+    towers_(kSize + 1, 0),
+    crystals_(EcalDenseIndex::kSizeForDenseIndexing + 1, 0)
+  {
+    BOOST_STATIC_ASSERT(sizeof(Code) >= sizeof(T().getStatusCode()));
+    for (int ieta = -int(kEBEta / 2); ieta <= int(kEBEta / 2); ++ieta) {
+      if (ieta == 0) continue;
+      for (int iphi = 1; iphi <= int(kEBPhi); ++iphi) {
+        const EcalTrigTowerDetId id(ieta > 0 ? 1 : -1, EcalBarrel, ieta > 0 ? ieta : -ieta, iphi);
+        typename EcalCondTowerObjectContainer<T>::const_iterator it = status.find(id.rawId());
+        if (it != status.end()) towers_[barrelIndex(ieta, iphi)] = it->getStatusCode();
+      }
+    }
+    for (int z = -1; z <= 1; z += 2) {
+      for (int ix = 1; ix <= int(kEESide); ++ix) {
+        for (int iy = 1; iy <= int(kEESide); ++iy) {
+          if (!EcalScDetId::validDetId(ix, iy, z)) continue;
+          typename EcalCondTowerObjectContainer<T>::const_iterator it = status.find(EcalScDetId(ix, iy, z).rawId());
+          if (it != status.end()) towers_[endcapIndex(ix, iy, z)] = it->getStatusCode();
+        }
+      }
+    }
+    const std::vector<uint16_t>& map = crystalTowers();
+    for (size_t i = 0; i < crystals_.size(); ++i) crystals_[i] = towers_[map[i]];
+  }
+
+  /// status of the tower of a crystal
+  Code crystal(uint32_t rawId) const { return crystals_[EcalDenseIndex::fromRawId(rawId)]; }
+  Code crystalItem(uint32_t denseIndex) const { return crystals_[denseIndex]; }
+
+  Code barrel(int ieta, int iphi) const { return towers_[barrelIndex(ieta, iphi)]; }
+  Code endcap(int ix, int iy, int zside) const { return towers_[endcapIndex(ix, iy, zside)]; }
+
+  /// status of an EcalTrigTowerDetId (barrel) or EcalScDetId
+  Code tower(uint32_t rawId) const { return towers_[towerIndex(rawId)]; }
+
+  /// per crystal statuses by dense index, kSizeForDenseIndexing + 1 entries
+  const Code* crystals() const { return &crystals_[0]; }
+
+ private:
+  std::vector<Code> towers_;
+  std::vector<Code> crystals_;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef CondFormats_EcalObjects_EcalWeightSetKernel_H
+#define CondFormats_EcalObjects_EcalWeightSetKernel_H
+/**
+ * Batch weight method on many frames at once.
+ *
+ * Applies an EcalWeightSet to N pedestal subtracted frames of 10 samples,
+ * stored one after the other (frames[10 * i + s]). For each frame the
+ * weights before or after the gain switch are chosen by gainSwitched[i],
+ * and the result is
+ *
+ *   params[3 * i + k] = sum_s W(k, s) * f(s)        (the rows of W, i.e.
+ *                                                    amplitude, pedestal, jitter)
+ *   chi2[i]           = sum_s,t f(s) * C(s, t) * f(t)
+ *
+ * the same products the per-digi SMatrix code computes, in double
+ * precision as there, the results being rounded to float: they agree with
+ * the SMatrix ones to the float rounding.
+ *
+ * The weights are copied once, transposed (sample major); each block of
+ * ecalsimd::kDoubleLanes frames is transposed as well so that every SIMD
+ * lane works on its own frame (see EcalSimd.h). The sums are done with the
+ * weights before the gain switch and, only for the blocks with a switched
+ * frame, with those after it, each frame taking its own.
+ *
+ * Transient object. compute() is const and can be called concurrently.
+ **/
+
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalWeightSet.h"
+
+class EcalWeightSetKernel {
+ public:
+  static const unsigned int kSamples = 10;
+  static const unsigned int kParams = 3;
+
+  explicit EcalWeightSetKernel(const EcalWeightSet& weights);
+
+  /// gainSwitched may be null (no switch in any frame), chi2 may be null (not computed)
+  void compute(size_t n, const float* frames, const uint8_t* gainSwitched, float* params, float* chi2) const;
+
+  /// single frame
+  void compute(const float* frame, bool gainSwitched, float* params, float* chi2) const;
+
+  /// number of frames processed at once by compute()
+  static int simdWidth();
+
+ private:
+  // [before, after][sample][param] and [before, after][t][s]
+  double weights_[2][kSamples][kParams];
+  double chi2Weights_[2][kSamples][kSamples];
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "CondFormats/EcalObjects/interface/EcalCalibrationSnapshot.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+
+EcalCalibrationSnapshot::Inputs::Inputs() :
+  intercalib(0), intercalibId(0),
+  adcToGeV(0), adcToGeVId(0),
+  apdpn(0), apdpnId(0),
+  apdpnRef(0), apdpnRefId(0),
+  alphas(0), alphasId(0),
+  timeCalib(0), timeCalibId(0),
+  timeOffset(0), timeOffsetId(0),
+  laserRegions(0),
+  laserTime(0)
+{}
+
+EcalCalibrationSnapshot::EcalCalibrationSnapshot() :
+  constants_(EcalDenseIndex::kSizeForDenseIndexing + 1),
+  laserEngine_(0),
+  valid_(false)
+{
+  Constants neutral = { 1., 0. };
+  std::fill(constants_.begin(), constants_.end(), neutral);
+}
+
+EcalCalibrationSnapshot::~EcalCalibrationSnapshot() {
+  delete laserEngine_;
+}
+
+bool EcalCalibrationSnapshot::sameKeys(const Inputs& in) const {
+  return in.intercalib == keys_.intercalib && in.intercalibId == keys_.intercalibId
+    && in.adcToGeV == keys_.adcToGeV && in.adcToGeVId == keys_.adcToGeVId
+    && in.apdpn == keys_.apdpn && in.apdpnId == keys_.apdpnId
+    && in.apdpnRef == keys_.apdpnRef && in.apdpnRefId == keys_.apdpnRefId
+    && in.alphas == keys_.alphas && in.alphasId == keys_.alphasId
+    && in.timeCalib == keys_.timeCalib && in.timeCalibId == keys_.timeCalibId
+    && in.timeOffset == keys_.timeOffset && in.timeOffsetId == keys_.timeOffsetId
+    && in.laserRegions == keys_.laserRegions
+    && (in.apdpn == 0 || in.laserTime.value() == keys_.laserTime.value());
+}
+
+bool EcalCalibrationSnapshot::update(const Inputs& inputs) {
+  if (valid_ && sameKeys(inputs)) return false;
+  build(inputs);
+  keys_ = inputs;
+  valid_ = true;
+  return true;
+}
+
+bool EcalCalibrationSnapshot::sameLaserKeys(const Inputs& in) const {
+  return laserEngine_ != 0
+    && in.apdpn == keys_.apdpn && in.apdpnId == keys_.apdpnId
+    && in.apdpnRef == keys_.apdpnRef && in.apdpnRefId == keys_.apdpnRefId
+    && in.alphas == keys_.alphas && in.alphasId == keys_.alphasId
+    && in.laserRegions == keys_.laserRegions;
+}
+
+void EcalCalibrationSnapshot::build(const Inputs& in) {
+  if (in.intercalib == 0) {
+    throw cms::Exception("EcalCalibrationSnapshot") << "intercalibration constants are required";
+  }
+  if (in.apdpn != 0 && (in.laserRegions == 0 || in.laserRegions->size() < EcalDenseIndex::kSizeForDenseIndexing)) {
+    throw cms::Exception("EcalCalibrationSnapshot") << "laser regions of the "
+      << EcalDenseIndex::kSizeForDenseIndexing << " crystals are required with the APD/PN ratios";
+  }
+
+  const float ebAdcToGeV = in.adcToGeV ? in.adcToGeV->getEBValue() : 1.;
+  const float eeAdcToGeV = in.adcToGeV ? in.adcToGeV->getEEValue() : 1.;
+  const float ebTimeOffset = in.timeOffset ? in.timeOffset->getEBValue() : 0.;
+  const float eeTimeOffset = in.timeOffset ? in.timeOffset->getEEValue() : 0.;
+
+  if (in.apdpn) {
+    if (!(valid_ && sameLaserKeys(in))) {
+      EcalLaserCorrectionEngine* engine = new EcalLaserCorrectionEngine(*in.apdpn, in.apdpnRef, in.alphas, *in.laserRegions);
+      delete laserEngine_;
+      laserEngine_ = engine;
+    }
+    laserEngine_->compute(in.laserTime, laser_);
+  } else {
+    delete laserEngine_;
+    laserEngine_ = 0;
+  }
+
+  for (size_t i = 0; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+    const bool eb = EcalDenseIndex::isBarrel(i);
+    Constants& c = constants_[i];
+
+    c.scale = in.intercalib->item(i) * (eb ? ebAdcToGeV : eeAdcToGeV);
+    if (in.apdpn) c.scale *= laser_[i];
+
+    c.timeOffset = (in.timeCalib ? in.timeCalib->item(i) : 0.f) + (eb ? ebTimeOffset : eeTimeOffset);
+  }
+}
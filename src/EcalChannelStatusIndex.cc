@@ -0,0 +1,47 @@
+#include "CondFormats/EcalObjects/interface/EcalChannelStatusIndex.h"
+
+const int EcalChannelStatusIndex::kNStatus;
+
+int EcalChannelStatusIndex::bitMask(Flag f) {
+  static const int masks[kNFlags] = {
+    EcalChannelStatusCode::HVbitMask, EcalChannelStatusCode::LVbitMask, EcalChannelStatusCode::DAQbitMask,
+    EcalChannelStatusCode::TPbitMask, EcalChannelStatusCode::TriggerbitMask,
+    EcalChannelStatusCode::TemperaturebitMask, EcalChannelStatusCode::DeadNeighbourbitMask
+  };
+  return masks[f];
+}
+
+EcalChannelStatusIndex::EcalChannelStatusIndex(const EcalChannelStatus& status) {
+  // fill word by word: one pass over the crystals, no read-modify-write of the bitsets
+  const uint32_t n = EcalDenseBitset::kSize;
+  for (uint32_t w = 0; w < EcalDenseBitset::kWords; ++w) {
+    EcalDenseBitset::Word statusWords[kNStatus] = {};
+    EcalDenseBitset::Word flagWords[kNFlags] = {};
+    const uint32_t first = w * EcalDenseBitset::kWordBits;
+    const uint32_t last = first + EcalDenseBitset::kWordBits < n ? first + EcalDenseBitset::kWordBits : n;
+    for (uint32_t i = first; i < last; ++i) {
+      const uint16_t code = status.item(i).getStatusCode();
+      const EcalDenseBitset::Word bit = EcalDenseBitset::Word(1) << (i - first);
+      statusWords[code & EcalChannelStatusCode::chStatusMask] |= bit;
+      for (int f = 0; f < kNFlags; ++f) {
+        if (code & bitMask(Flag(f))) flagWords[f] |= bit;
+      }
+    }
+    for (int s = 0; s < kNStatus; ++s) status_[s].words()[w] = statusWords[s];
+    for (int f = 0; f < kNFlags; ++f) flags_[f].words()[w] = flagWords[f];
+  }
+}
+
+EcalDenseBitset EcalChannelStatusIndex::statusRange(int lo, int hi) const {
+  EcalDenseBitset r;
+  for (int s = lo < 0 ? 0 : lo; s <= hi && s < kNStatus; ++s) r |= status_[s];
+  return r;
+}
+
+EcalDenseBitset EcalChannelStatusIndex::flags(int mask) const {
+  EcalDenseBitset r;
+  for (int f = 0; f < kNFlags; ++f) {
+    if (mask & bitMask(Flag(f))) r |= flags_[f];
+  }
+  return r;
+}
@@ -0,0 +1,126 @@
+#include "CondFormats/EcalObjects/interface/EcalCondObjectContainerView.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const uint32_t EcalCondObjectFile::kVersion;
+
+namespace {
+  const char kMagic[8] = { 'E', 'C', 'A', 'L', 'C', 'O', 'N', 'D' };
+
+  bool writeAll(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+      const ssize_t n = ::write(fd, p, size);
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) return false;
+      p += n;
+      size -= n;
+    }
+    return true;
+  }
+}
+
+uint64_t EcalCondObjectFile::checksum(const void* data, size_t size, uint64_t h) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+void EcalCondObjectFile::write(const std::string& path, const std::string& typeTag, uint32_t itemSize,
+                               const void* eb, uint32_t nEB, const void* ee, uint32_t nEE) {
+  Header h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.version = kVersion;
+  h.itemSize = itemSize;
+  std::strncpy(h.typeTag, typeTag.c_str(), sizeof(h.typeTag) - 1);
+  h.nEB = nEB;
+  h.nEE = nEE;
+
+  // the checksum runs over the EB then the EE bytes, as they are laid out in the file
+  const size_t ebBytes = size_t(nEB) * itemSize, eeBytes = size_t(nEE) * itemSize;
+  h.checksum = checksum(ee, eeBytes, checksum(eb, ebBytes));
+
+  // written aside, in a unique file of the same directory, and renamed: readers
+  // never map a partial file, and concurrent writers do not share the temporary
+  std::vector<char> tmp(path.begin(), path.end());
+  const char suffix[] = ".XXXXXX";
+  tmp.insert(tmp.end(), suffix, suffix + sizeof(suffix));
+  const int fd = ::mkstemp(&tmp[0]);
+  if (fd < 0) {
+    throw cms::Exception("EcalCondObjectFile") << "cannot create a temporary file for " << path << ": " << std::strerror(errno);
+  }
+  const bool ok = ::fchmod(fd, 0644) == 0
+    && writeAll(fd, &h, sizeof(h)) && writeAll(fd, eb, ebBytes) && writeAll(fd, ee, eeBytes);
+  const int error = errno;
+  if (::close(fd) != 0 || !ok) {
+    ::unlink(&tmp[0]);
+    throw cms::Exception("EcalCondObjectFile") << "cannot write " << &tmp[0] << ": " << std::strerror(ok ? errno : error);
+  }
+  if (std::rename(&tmp[0], path.c_str()) != 0) {
+    const int error = errno;
+    ::unlink(&tmp[0]);
+    throw cms::Exception("EcalCondObjectFile") << "cannot rename " << &tmp[0] << " to " << path << ": " << std::strerror(error);
+  }
+}
+
+EcalCondObjectFile::Mapping::Mapping(const std::string& path) : data_(0), size_(0) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw cms::Exception("EcalCondObjectFile") << "cannot open " << path << ": " << std::strerror(errno);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < off_t(sizeof(Header))) {
+    ::close(fd);
+    throw cms::Exception("EcalCondObjectFile") << path << " is too short for an ECAL conditions file";
+  }
+  size_ = st.st_size;
+  void* p = ::mmap(0, size_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    throw cms::Exception("EcalCondObjectFile") << "cannot map " << path << ": " << std::strerror(errno);
+  }
+  data_ = static_cast<const char*>(p);
+}
+
+EcalCondObjectFile::Mapping::~Mapping() {
+  if (data_) ::munmap(const_cast<char*>(data_), size_);
+}
+
+const EcalCondObjectFile::Header& EcalCondObjectFile::validate(const Mapping& m, uint32_t itemSize,
+                                                               const std::string& typeTag, bool verifyChecksum) {
+  const Header& h = *reinterpret_cast<const Header*>(m.data());
+  if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw cms::Exception("EcalCondObjectFile") << "not an ECAL conditions file";
+  }
+  if (h.version != kVersion) {
+    throw cms::Exception("EcalCondObjectFile") << "format version " << h.version << ", expected " << kVersion;
+  }
+  const std::string fileTag(h.typeTag, strnlen(h.typeTag, sizeof(h.typeTag)));
+  if (h.itemSize != itemSize || fileTag != typeTag.substr(0, sizeof(h.typeTag) - 1)) {
+    throw cms::Exception("EcalCondObjectFile") << "file holds items of type '" << fileTag << "' (" << h.itemSize
+      << " bytes), expected '" << typeTag << "' (" << itemSize << " bytes)";
+  }
+  if (h.nEB > EcalDenseIndex::kEBSize || h.nEE > EcalDenseIndex::kEESize
+      || m.size() != sizeof(Header) + (size_t(h.nEB) + h.nEE) * itemSize) {
+    throw cms::Exception("EcalCondObjectFile") << "inconsistent sizes: " << h.nEB << " EB and " << h.nEE
+      << " EE items of " << itemSize << " bytes in " << m.size() << " bytes";
+  }
+  if (verifyChecksum && checksum(m.data() + sizeof(Header), m.size() - sizeof(Header)) != h.checksum) {
+    throw cms::Exception("EcalCondObjectFile") << "checksum mismatch";
+  }
+  return h;
+}
@@ -0,0 +1,61 @@
+#include "CondFormats/EcalObjects/interface/EcalDeadNeighbourMask.h"
+
+const uint32_t EcalDeadNeighbourMask::kCentre;
+const uint32_t EcalDeadNeighbourMask::k3x3;
+const uint32_t EcalDeadNeighbourMask::k3x3Ring;
+const uint32_t EcalDeadNeighbourMask::k5x5;
+const uint32_t EcalDeadNeighbourMask::k5x5Ring;
+
+EcalDeadNeighbourMask::EcalDeadNeighbourMask(const EcalChannelStatus& status, int minStatus) :
+  minStatus_(minStatus),
+  masks_(EcalDenseIndex::kSizeForDenseIndexing + 1, 0)
+{
+  std::vector<uint8_t> bad(EcalDenseIndex::kSizeForDenseIndexing, 0);
+  for (uint32_t i = 0; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+    bad[i] = status.item(i).getDecodedStatusCode() >= minStatus;
+  }
+  fillBarrel(bad);
+  fillEndcap(bad);
+}
+
+void EcalDeadNeighbourMask::fillBarrel(const std::vector<uint8_t>& bad) {
+  // the EB dense index is eta * MAX_IPHI + iphi - 1, eta = 0..169 running over ieta = -85..-1, 1..85
+  const int nEta = 2 * EBDetId::MAX_IETA;
+  const int nPhi = EBDetId::MAX_IPHI;
+  for (int eta = 0; eta < nEta; ++eta) {
+    for (int phi = 0; phi < nPhi; ++phi) {
+      uint32_t m = 0;
+      for (int d1 = -2; d1 <= 2; ++d1) {
+        const int e = eta + d1;
+        if (e < 0 || e >= nEta) continue;
+        for (int d2 = -2; d2 <= 2; ++d2) {
+          const int p = (phi + d2 + nPhi) % nPhi;
+          if (bad[e * nPhi + p]) m |= bit(d1, d2);
+        }
+      }
+      masks_[eta * nPhi + phi] = m;
+    }
+  }
+}
+
+void EcalDeadNeighbourMask::fillEndcap(const std::vector<uint8_t>& bad) {
+  // dense index of each (z, ix, iy), -1 outside of the endcaps, with a 2 crystal margin
+  const int n = EEDetId::IX_MAX + 4;
+  std::vector<int32_t> grid(2 * n * n, -1);
+  for (uint32_t i = EcalDenseIndex::kEBSize; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+    const EEDetId id(EcalDenseIndex::toRawId(i));
+    grid[((id.zside() > 0) * n + id.ix() + 1) * n + id.iy() + 1] = i;
+  }
+  for (uint32_t i = EcalDenseIndex::kEBSize; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+    const EEDetId id(EcalDenseIndex::toRawId(i));
+    const int z = id.zside() > 0;
+    uint32_t m = 0;
+    for (int d1 = -2; d1 <= 2; ++d1) {
+      for (int d2 = -2; d2 <= 2; ++d2) {
+        const int32_t j = grid[(z * n + id.ix() + 1 + d1) * n + id.iy() + 1 + d2];
+        if (j >= 0 && bad[j]) m |= bit(d1, d2);
+      }
+    }
+    masks_[i] = m;
+  }
+}
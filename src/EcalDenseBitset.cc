@@ -0,0 +1,5 @@
+#include "CondFormats/EcalObjects/interface/EcalDenseBitset.h"
+
+const uint32_t EcalDenseBitset::kSize;
+const uint32_t EcalDenseBitset::kWordBits;
+const uint32_t EcalDenseBitset::kWords;
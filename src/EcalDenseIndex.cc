@@ -0,0 +1,35 @@
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+
+const uint32_t EcalDenseIndex::kEBSize;
+const uint32_t EcalDenseIndex::kEESize;
+const uint32_t EcalDenseIndex::kSizeForDenseIndexing;
+
+uint16_t EcalDenseIndex::eeTable_[EcalDenseIndex::kEETableSize];
+
+// fills the EE table when the library is loaded; the entries hold
+// denseIndex+1 so that the zero initialized table reads as invalid
+struct EcalDenseIndexTableFiller {
+  EcalDenseIndexTableFiller() {
+    for (int iz = -1; iz <= 1; iz += 2) {
+      for (int ix = EEDetId::IX_MIN; ix <= EEDetId::IX_MAX; ++ix) {
+        for (int iy = EEDetId::IY_MIN; iy <= EEDetId::IY_MAX; ++iy) {
+          if (!EEDetId::validDetId(ix, iy, iz)) continue;
+          const EEDetId id(ix, iy, iz);
+          EcalDenseIndex::eeTable_[id.rawId() & (EcalDenseIndex::kEETableSize - 1)] = id.denseIndex() + 1;
+        }
+      }
+    }
+  }
+};
+
+static EcalDenseIndexTableFiller ecalDenseIndexTableFiller;
+
+void EcalDenseIndex::fromRawIds(const uint32_t* rawIds, size_t n, uint32_t* denseIndices) {
+  for (size_t i = 0; i < n; ++i) denseIndices[i] = fromRawId(rawIds[i]);
+}
+
+uint32_t EcalDenseIndex::toRawId(uint32_t denseIndex) {
+  if (denseIndex < kEBSize) return EBDetId::detIdFromDenseIndex(denseIndex).rawId();
+  if (denseIndex < kSizeForDenseIndexing) return EEDetId::detIdFromDenseIndex(denseIndex - kEBSize).rawId();
+  return 0;
+}
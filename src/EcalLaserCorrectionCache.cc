@@ -0,0 +1,107 @@
+#include "CondFormats/EcalObjects/interface/EcalLaserCorrectionCache.h"
+#include "CondFormats/EcalObjects/interface/EcalLaserCorrectionEngine.h"
+
+#include <exception>
+#include <future>
+#include <list>
+#include <mutex>
+
+struct EcalLaserCorrectionCache::Impl {
+  struct Entry {
+    unsigned long long token;
+    edm::TimeValue_t time;
+    unsigned long long serial;  // identifies the entry, even after clear() and a new entry for the same bucket
+    std::shared_future<CorrectionsPtr> value;
+  };
+
+  Impl() : evaluations(0) {}
+
+  std::mutex mutex;
+  std::list<Entry> entries;        // most recently used first
+  unsigned long long evaluations;  // also the serial of the next entry
+};
+
+EcalLaserCorrectionCache::EcalLaserCorrectionCache(unsigned int bucketWidth, size_t maxEntries) :
+  bucketWidth_(bucketWidth),
+  maxEntries_(maxEntries > 0 ? maxEntries : 1),
+  impl_(new Impl)
+{}
+
+EcalLaserCorrectionCache::~EcalLaserCorrectionCache() { delete impl_; }
+
+edm::Timestamp EcalLaserCorrectionCache::bucketTime(edm::Timestamp t) const {
+  if (bucketWidth_ == 0) return t;
+  const edm::TimeValue_t seconds = t.value() >> 32;
+  const edm::TimeValue_t start = seconds / bucketWidth_ * bucketWidth_;
+  // center of the bucket, half seconds going to the microsecond part
+  const edm::TimeValue_t center = ((start + bucketWidth_ / 2) << 32) | (bucketWidth_ % 2 ? 500000 : 0);
+  return edm::Timestamp(center);
+}
+
+EcalLaserCorrectionCache::CorrectionsPtr
+EcalLaserCorrectionCache::get(unsigned long long iovToken, edm::Timestamp t, const Evaluator& evaluate) {
+  const edm::Timestamp bt = bucketTime(t);
+
+  typedef std::list<Impl::Entry> Entries;
+  Entries& entries = impl_->entries;
+  std::promise<CorrectionsPtr> promise;
+  std::shared_future<CorrectionsPtr> cached;
+  unsigned long long serial = 0;
+  {
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    for (Entries::iterator it = entries.begin(); it != entries.end(); ++it) {
+      if (it->token == iovToken && it->time == bt.value()) {
+        entries.splice(entries.begin(), entries, it);
+        cached = it->value;
+        break;
+      }
+    }
+    if (!cached.valid()) {
+      Impl::Entry e;
+      e.token = iovToken;
+      e.time = bt.value();
+      e.serial = serial = impl_->evaluations;
+      e.value = promise.get_future().share();
+      entries.push_front(e);
+      if (entries.size() > maxEntries_) entries.pop_back();
+      ++impl_->evaluations;
+    }
+  }
+  // hit: wait, outside of the lock, in case the bucket is still being computed
+  if (cached.valid()) return cached.get();
+
+  try {
+    boost::shared_ptr<Corrections> corrections(new Corrections);
+    evaluate(bt, *corrections);
+    CorrectionsPtr result(corrections);
+    promise.set_value(result);
+    return result;
+  } catch (...) {
+    // do not keep the failed bucket, waiting threads get the exception; the entry
+    // may already be gone (evicted, clear()) and the bucket requested again
+    promise.set_exception(std::current_exception());
+    std::lock_guard<std::mutex> guard(impl_->mutex);
+    for (Entries::iterator it = entries.begin(); it != entries.end(); ++it) {
+      if (it->serial == serial) {
+        entries.erase(it);
+        break;
+      }
+    }
+    throw;
+  }
+}
+
+EcalLaserCorrectionCache::CorrectionsPtr
+EcalLaserCorrectionCache::get(unsigned long long iovToken, edm::Timestamp t, const EcalLaserCorrectionEngine& engine) {
+  return get(iovToken, t, [&engine](edm::Timestamp bt, Corrections& c) { engine.compute(bt, c); });
+}
+
+unsigned long long EcalLaserCorrectionCache::evaluations() const {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  return impl_->evaluations;
+}
+
+void EcalLaserCorrectionCache::clear() {
+  std::lock_guard<std::mutex> guard(impl_->mutex);
+  impl_->entries.clear();
+}
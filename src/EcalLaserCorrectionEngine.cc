@@ -0,0 +1,107 @@
+#include "CondFormats/EcalObjects/interface/EcalLaserCorrectionEngine.h"
+#include "CondFormats/EcalObjects/src/EcalLaserCorrectionKernel.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cmath>
+
+namespace {
+  // columns are padded to a whole number of the widest vectors
+  size_t paddedSize() {
+    const size_t n = EcalDenseIndex::kSizeForDenseIndexing;
+    return (n + 15) / 16 * 16;
+  }
+}
+
+EcalLaserCorrectionEngine::EcalLaserCorrectionEngine(const EcalLaserAPDPNRatios& apdpn,
+                                                     const EcalLaserAPDPNRatiosRef* apdpnRef,
+                                                     const EcalLaserAlphas* alphas,
+                                                     const std::vector<uint8_t>& laserRegions) :
+  times_(apdpn.getTimeMap()),
+  p1_(paddedSize(), 1.f), p2_(paddedSize(), 1.f), p3_(paddedSize(), 1.f),
+  logRef_(paddedSize(), 0.f), alpha_(paddedSize(), 0.f),
+  region_(paddedSize(), int32_t(times_.size())), valid_(paddedSize(), 0)
+{
+  if (laserRegions.size() < EcalDenseIndex::kSizeForDenseIndexing) {
+    throw cms::Exception("EcalLaserCorrectionEngine") << "laser regions of the "
+      << EcalDenseIndex::kSizeForDenseIndexing << " crystals are required, got " << laserRegions.size();
+  }
+  const EcalLaserAPDPNRatios::EcalLaserAPDPNRatiosMap& pairs = apdpn.getLaserMap();
+  for (size_t i = 0; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+    const EcalLaserAPDPNRatios::EcalLaserAPDPNpair& p = pairs.item(i);
+    const float ref = apdpnRef ? apdpnRef->item(i) : 1.f;
+    p1_[i] = p.p1;
+    p2_[i] = p.p2;
+    p3_[i] = p.p3;
+    alpha_[i] = alphas ? alphas->item(i) : 1.f;
+    if (laserRegions[i] < times_.size()) region_[i] = laserRegions[i];
+    if (ref > 0 && region_[i] < int32_t(times_.size())) {
+      logRef_[i] = std::log(ref);
+      valid_[i] = -1;
+    }
+  }
+}
+
+void EcalLaserCorrectionEngine::regionWeight(const EcalLaserAPDPNRatios::EcalLaserTimeStamp& ts, edm::Timestamp t,
+                                             float& weight, int32_t& secondSegment) {
+  const double tv = double(t.value());
+  const double t1 = double(ts.t1.value()), t2 = double(ts.t2.value()), t3 = double(ts.t3.value());
+  double w;
+  if (t.value() < ts.t2.value()) {
+    secondSegment = 0;
+    w = t2 > t1 ? (tv - t1) / (t2 - t1) : 0.;
+  } else {
+    secondSegment = -1;
+    w = t3 > t2 ? (tv - t2) / (t3 - t2) : 1.;
+  }
+  weight = w < 0. ? 0.f : (w > 1. ? 1.f : float(w));
+}
+
+float EcalLaserCorrectionEngine::correction(const EcalLaserAPDPNRatios::EcalLaserAPDPNpair& p,
+                                            const EcalLaserAPDPNRatios::EcalLaserTimeStamp& ts,
+                                            float apdpnRef, float alpha, edm::Timestamp t) {
+  float w;
+  int32_t second;
+  regionWeight(ts, t, w, second);
+  const float a = second ? p.p2 : p.p1;
+  const float b = second ? p.p3 : p.p2;
+  const float r = a + w * (b - a);
+  if (apdpnRef <= 0 || r <= 0) return 1.f;
+  return std::pow(r / apdpnRef, -alpha);
+}
+
+int EcalLaserCorrectionEngine::simdWidth() {
+  static const int lanes = ecalsimd::runtimeLanes();
+  return lanes;
+}
+
+void EcalLaserCorrectionEngine::compute(edm::Timestamp t, std::vector<float>& corrections) const {
+  corrections.resize(EcalDenseIndex::kSizeForDenseIndexing);
+  compute(t, &corrections[0]);
+}
+
+void EcalLaserCorrectionEngine::compute(edm::Timestamp t, float* corrections) const {
+  using namespace ecalsimd;
+
+  // per region weights, plus a neutral slot for crystals without region
+  const size_t nRegions = times_.size();
+  std::vector<float> weight(nRegions + 1, 0.f);
+  std::vector<int32_t> second(nRegions + 1, 0);
+  for (size_t r = 0; r < nRegions; ++r) regionWeight(times_[r], t, weight[r], second[r]);
+
+  const size_t n = EcalDenseIndex::kSizeForDenseIndexing;
+  const ecallaser::Columns c = { &p1_[0], &p2_[0], &p3_[0], &logRef_[0], &alpha_[0], &weight[0],
+                      &region_[0], &valid_[0], &second[0] };
+  size_t nVec;
+#ifdef ECAL_LASER_RUNTIME_DISPATCH
+  const int lanes = simdWidth();
+  if (lanes == 16 && kLanes < 16) nVec = ecallaser::computeAVX512(c, n, corrections);
+  else if (lanes == 8 && kLanes < 8) nVec = ecallaser::computeAVX2(c, n, corrections);
+  else
+#endif
+  nVec = ecallaser::computeVectors<vfloat, vint>(c, n, corrections);
+  for (size_t i = nVec; i < n; ++i) {
+    const int32_t r = region_[i];
+    corrections[i] = ecallaser::kernel<float, int32_t>(p1_[i], p2_[i], p3_[i], logRef_[i], alpha_[i], valid_[i],
+                                                       weight[r], second[r]);
+  }
+}
@@ -0,0 +1,17 @@
+// The 16 lane instantiation of the laser correction kernel, selected at
+// run time by EcalLaserCorrectionEngine::compute() on cpus with AVX-512F.
+// The whole translation unit is compiled for AVX-512F, as with -mavx512f,
+// so that the target applies to everything the kernel inlines; it must
+// include nothing else (see EcalSimd.h).
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define ECAL_SIMD_LANES 16
+#pragma GCC target("avx512f")
+#endif
+
+#include "CondFormats/EcalObjects/src/EcalLaserCorrectionKernel.h"
+
+#ifdef ECAL_LASER_RUNTIME_DISPATCH
+size_t ecallaser::computeAVX512(const Columns& c, size_t n, float* corrections) {
+  return computeVectors<ecalsimd::vfloat, ecalsimd::vint>(c, n, corrections);
+}
+#endif
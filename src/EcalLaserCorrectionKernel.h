@@ -0,0 +1,72 @@
+#ifndef CondFormats_EcalObjects_src_EcalLaserCorrectionKernel_H
+#define CondFormats_EcalObjects_src_EcalLaserCorrectionKernel_H
+/**
+ * The vector kernel of EcalLaserCorrectionEngine::compute(), private to
+ * the package. It is instantiated with the default vectors of each
+ * translation unit including it: EcalLaserCorrectionEngine.cc for the
+ * baseline instruction set, EcalLaserCorrectionEngineAVX2.cc and
+ * EcalLaserCorrectionEngineAVX512.cc for the wider ones. Everything here
+ * is always inlined (see EcalSimd.h).
+ **/
+
+#include <cstddef>
+#include <boost/cstdint.hpp>
+
+#include "CondFormats/EcalObjects/interface/EcalSimd.h"
+
+// the wide kernels are built with #pragma GCC target, which clang does not know
+#if defined(ECAL_SIMD_VECTOR_EXTENSIONS) && defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define ECAL_LASER_RUNTIME_DISPATCH 1
+#endif
+
+namespace ecallaser {
+
+  /// the columns of the engine and the per region weights
+  struct Columns {
+    const float *p1, *p2, *p3, *logRef, *alpha, *weight;
+    const int32_t *region, *valid, *second;
+  };
+
+  template <typename VF, typename VI>
+  ECAL_SIMD_INLINE VF kernel(VF p1, VF p2, VF p3, VF logRef, VF alpha, VI valid, VF w, VI second) {
+    using namespace ecalsimd;
+    const VF a = select(second, p2, p1);
+    const VF b = select(second, p3, p2);
+    const VF r = a + w * (b - a);
+    const VI ok = valid & gt(r, splat<VF>(0.f));
+    const VF safeR = select(ok, r, splat<VF>(1.f));
+    const VF c = ecalsimd::exp<VF, VI>(alpha * (logRef - ecalsimd::log<VF, VI>(safeR)));
+    return select(ok, c, splat<VF>(1.f));
+  }
+
+  /// the first n / L * L crystals, L lanes at a time; returns the number done
+  template <typename VF, typename VI>
+  ECAL_SIMD_INLINE size_t computeVectors(const Columns& c, size_t n, float* corrections) {
+    using namespace ecalsimd;
+    const int kL = sizeof(VF) / sizeof(float);
+    const size_t nVec = n / kL * kL;
+    for (size_t i = 0; i < nVec; i += kL) {
+      float w[kL];
+      int32_t s[kL];
+      for (int l = 0; l < kL; ++l) {
+        const int32_t r = c.region[i + l];
+        w[l] = c.weight[r];
+        s[l] = c.second[r];
+      }
+      const VF v = kernel<VF, VI>(load<VF>(c.p1 + i), load<VF>(c.p2 + i), load<VF>(c.p3 + i),
+                                  load<VF>(c.logRef + i), load<VF>(c.alpha + i),
+                                  load<VI>(c.valid + i), load<VF>(w), load<VI>(s));
+      store(corrections + i, v);
+    }
+    return nVec;
+  }
+
+#ifdef ECAL_LASER_RUNTIME_DISPATCH
+  /// computeVectors() with 8 and 16 lanes, to be called only if the cpu supports AVX2 and AVX-512F
+  size_t computeAVX2(const Columns& c, size_t n, float* corrections);
+  size_t computeAVX512(const Columns& c, size_t n, float* corrections);
+#endif
+}
+
+#endif
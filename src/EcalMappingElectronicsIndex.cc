@@ -0,0 +1,72 @@
+#include "CondFormats/EcalObjects/interface/EcalMappingElectronicsIndex.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+const uint32_t EcalMappingElectronicsIndex::kDccs;
+const uint32_t EcalMappingElectronicsIndex::kTowers;
+const uint32_t EcalMappingElectronicsIndex::kStrips;
+const uint32_t EcalMappingElectronicsIndex::kXtals;
+const uint32_t EcalMappingElectronicsIndex::kTccs;
+const uint32_t EcalMappingElectronicsIndex::kTriggerTowers;
+const uint32_t EcalMappingElectronicsIndex::kElectronicsSize;
+const uint32_t EcalMappingElectronicsIndex::kTriggerSize;
+
+EcalMappingElectronicsIndex::EcalMappingElectronicsIndex(const EcalMappingElectronics& mapping) :
+  detIds_(kElectronicsSize + 1, 0),
+  offsets_(kTriggerSize + 2, 0)
+{
+  // crystals without a mapping entry have null ids and are skipped
+  std::vector<uint32_t> towerOf(EcalDenseIndex::kSizeForDenseIndexing, kTriggerSize);
+  for (uint32_t d = 0; d < EcalDenseIndex::kSizeForDenseIndexing; ++d) {
+    const EcalMappingElement& m = mapping.item(d);
+    if (m.electronicsid == 0 && m.triggerid == 0) continue;
+    const uint32_t rawId = EcalDenseIndex::toRawId(d);
+
+    const EcalElectronicsId eid(m.electronicsid);
+    const uint32_t e = electronicsIndex(eid.dccId(), eid.towerId(), eid.stripId(), eid.xtalId());
+    if (e == kElectronicsSize) {
+      throw cms::Exception("EcalMappingElectronicsIndex") << "crystal " << rawId << " has an electronics id out of range: dcc "
+        << eid.dccId() << " tower " << eid.towerId() << " strip " << eid.stripId() << " xtal " << eid.xtalId();
+    }
+    if (detIds_[e] != 0) {
+      throw cms::Exception("EcalMappingElectronicsIndex") << "crystals " << detIds_[e] << " and " << rawId
+        << " have the same electronics id " << m.electronicsid;
+    }
+    detIds_[e] = rawId;
+
+    const EcalTriggerElectronicsId tid(m.triggerid);
+    const uint32_t t = triggerTowerIndex(tid.tccId(), tid.ttId());
+    if (t == kTriggerSize) {
+      throw cms::Exception("EcalMappingElectronicsIndex") << "crystal " << rawId << " has a trigger id out of range: tcc "
+        << tid.tccId() << " tt " << tid.ttId();
+    }
+    towerOf[d] = t;
+    ++offsets_[t + 1];
+  }
+
+  // counts to offsets, then the crystals in dense index order
+  for (uint32_t t = 0; t <= kTriggerSize; ++t) offsets_[t + 1] += offsets_[t];
+  crystals_.resize(offsets_[kTriggerSize] + 1, 0);
+  std::vector<uint32_t> next(offsets_.begin(), offsets_.end() - 1);
+  for (uint32_t d = 0; d < EcalDenseIndex::kSizeForDenseIndexing; ++d) {
+    if (towerOf[d] != kTriggerSize) crystals_[next[towerOf[d]]++] = EcalDenseIndex::toRawId(d);
+  }
+}
+
+const EcalMappingElectronicsIndex& EcalMappingElectronicsIndexCache::get(const EcalMappingElectronics& mapping,
+                                                                        unsigned long long iovToken) const {
+#if defined(__GNUC__)
+  for (;;) {
+    Entry* p = __atomic_load_n(&entry_, __ATOMIC_ACQUIRE);
+    if (p && p->source == &mapping && p->token == iovToken) return p->index;
+    // the fresh entry owns the one it replaces; if another thread replaced it first, start over
+    Entry* fresh = new Entry(mapping, iovToken, p);
+    if (__sync_bool_compare_and_swap(&entry_, p, fresh)) return fresh->index;
+    fresh->previous = 0;
+    delete fresh;
+  }
+#else
+  if (!entry_ || entry_->source != &mapping || entry_->token != iovToken) entry_ = new Entry(mapping, iovToken, entry_);
+  return entry_->index;
+#endif
+}
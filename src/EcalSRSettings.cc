@@ -6,6 +6,8 @@
 #include <stdlib.h>
 #include <cassert>
 #include <algorithm>
+#include <cstring>
+#include <boost/cstdint.hpp>
 
 using namespace std;
 
@@ -204,3 +206,173 @@ std::ostream& operator<< (std::ostream& o, const EcalSRSettings& val){
 
   return o;
 }
+
+namespace {
+  const char srMagic[8] = { 'E', 'C', 'A', 'L', 'S', 'R', 'S', '1' };
+
+  // Binary encoding: unsigned varints (7 bits per byte, low bits first),
+  // signed integers zigzag encoded, floats as the 4 bytes of their IEEE 754
+  // bit pattern, least significant first whatever the host byte order. A
+  // vector is its length followed by (run length, value) pairs.
+  class SRWriter {
+  public:
+    explicit SRWriter(std::ostream& o): o_(o){}
+
+    void varint(uint64_t v){
+      char buf[10];
+      int n = 0;
+      while(v >= 0x80){ buf[n++] = char(v | 0x80); v >>= 7; }
+      buf[n++] = char(v);
+      o_.write(buf, n);
+    }
+
+    void put(int v){ varint((uint64_t(int64_t(v)) << 1) ^ uint64_t(int64_t(v) >> 63)); }
+    void put(short v){ put(int(v)); }
+    void put(float v){
+      uint32_t bits;
+      memcpy(&bits, &v, sizeof(bits));
+      char buf[4];
+      for(int k = 0; k < 4; ++k) buf[k] = char(bits >> (8 * k));
+      o_.write(buf, sizeof(buf));
+    }
+
+    template<typename T>
+    void put(const vector<T>& v){
+      varint(v.size());
+      for(size_t i = 0; i < v.size(); ){
+        size_t j = i + 1;
+        while(j < v.size() && same(v[j], v[i])) ++j;
+        varint(j - i);
+        put(v[i]);
+        i = j;
+      }
+    }
+
+    template<typename T>
+    void put(const vector<vector<T> >& v){
+      varint(v.size());
+      for(size_t i = 0; i < v.size(); ++i) put(v[i]);
+    }
+
+  private:
+    template<typename T>
+    static bool same(const T& a, const T& b){ return memcmp(&a, &b, sizeof(T)) == 0; }
+
+    std::ostream& o_;
+  };
+
+  class SRReader {
+  public:
+    explicit SRReader(std::istream& i): i_(i){}
+
+    uint64_t varint(){
+      uint64_t v = 0;
+      for(int shift = 0; shift < 64; shift += 7){
+        const int c = i_.get();
+        if(c == std::istream::traits_type::eof()) truncated();
+        v |= uint64_t(c & 0x7F) << shift;
+        if(!(c & 0x80)) return v;
+      }
+      throw cms::Exception("EcalSRSettings") << "malformed varint in binary settings";
+    }
+
+    void get(int& v){ const uint64_t z = varint(); v = int(int64_t(z >> 1) ^ -int64_t(z & 1)); }
+    void get(short& v){ int x; get(x); v = x; }
+    void get(float& v){
+      unsigned char buf[4];
+      if(!i_.read(reinterpret_cast<char*>(buf), sizeof(buf))) truncated();
+      uint32_t bits = 0;
+      for(int k = 0; k < 4; ++k) bits |= uint32_t(buf[k]) << (8 * k);
+      memcpy(&v, &bits, sizeof(v));
+    }
+
+    template<typename T>
+    void get(vector<T>& v){
+      const uint64_t n = length();
+      v.clear();
+      v.reserve(n);
+      while(v.size() < n){
+        const uint64_t run = varint();
+        if(run == 0 || run > n - v.size()){
+          throw cms::Exception("EcalSRSettings") << "invalid run length " << run << " in binary settings";
+        }
+        T x;
+        get(x);
+        v.insert(v.end(), run, x);
+      }
+    }
+
+    template<typename T>
+    void get(vector<vector<T> >& v){
+      v.resize(length());
+      for(size_t i = 0; i < v.size(); ++i) get(v[i]);
+    }
+
+  private:
+    uint64_t length(){
+      const uint64_t n = varint();
+      //no setting is longer than one element per crystal
+      if(n > 75848) throw cms::Exception("EcalSRSettings") << "invalid vector length " << n << " in binary settings";
+      return n;
+    }
+
+    static void truncated(){
+      throw cms::Exception("EcalSRSettings") << "truncated binary settings";
+    }
+
+    std::istream& i_;
+  };
+
+  //the fields in the order of the binary form
+  template<typename Stream, typename Settings>
+  void srFields(Stream& s, Settings& val){
+    s.put(val.deltaEta_);
+    s.put(val.deltaPhi_);
+    s.put(val.ecalDccZs1stSample_);
+    s.put(val.ebDccAdcToGeV_);
+    s.put(val.eeDccAdcToGeV_);
+    s.put(val.dccNormalizedWeights_);
+    s.put(val.symetricZS_);
+    s.put(val.srpLowInterestChannelZS_);
+    s.put(val.srpHighInterestChannelZS_);
+    s.put(val.actions_);
+    s.put(val.tccMasksFromConfig_);
+    s.put(val.srpMasksFromConfig_);
+    s.put(val.dccMasks_);
+    s.put(val.srfMasks_);
+    s.put(val.substitutionSrfs_);
+    s.put(val.testerTccEmuSrpIds_);
+    s.put(val.testerSrpEmuSrpIds_);
+    s.put(val.testerDccTestSrpIds_);
+    s.put(val.testerSrpTestSrpIds_);
+    s.put(val.bxOffsets_);
+    s.put(val.bxGlobalOffset_);
+    s.put(val.automaticMasks_);
+    s.put(val.automaticSrpSelect_);
+  }
+
+  //adapts the reader to srFields()
+  struct SRReadFields {
+    explicit SRReadFields(SRReader& r): r_(r){}
+    template<typename T> void put(T& x){ r_.get(x); }
+    SRReader& r_;
+  };
+}
+
+void writeBinary(std::ostream& o, const EcalSRSettings& val){
+  o.write(srMagic, sizeof(srMagic));
+  SRWriter w(o);
+  srFields(w, val);
+}
+
+void readBinary(std::istream& i, EcalSRSettings& val){
+  char magic[sizeof(srMagic)];
+  if(!i.read(magic, sizeof(magic)) || memcmp(magic, srMagic, sizeof(srMagic)) != 0){
+    throw cms::Exception("EcalSRSettings") << "not a binary EcalSRSettings stream";
+  }
+  SRReader r(i);
+  SRReadFields f(r);
+  EcalSRSettings tmp;
+  srFields(f, tmp);
+  val = tmp;
+}
@@ -0,0 +1,117 @@
+#include "CondFormats/EcalObjects/interface/EcalSRSettingsTable.h"
+#include "DataFormats/EcalDetId/interface/EcalElectronicsId.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <climits>
+#include <cmath>
+#include <map>
+
+const unsigned int EcalSRSettingsTable::kNWeights;
+const int32_t EcalSRSettingsTable::kWeightScale;
+const int32_t EcalSRSettingsTable::kThresholdScale;
+const int32_t EcalSRSettingsTable::kMinHwValue;
+const int32_t EcalSRSettingsTable::kMaxHwValue;
+
+namespace {
+  const int kNDccs = EcalSRSettings::nDccs_;
+
+  // checks a setting has one of the lengths understood by resolve()
+  template <typename T>
+  void checkLength(const std::vector<T>& v, const char* name) {
+    const size_t n = v.size();
+    if (n == 1 || n == 2 || n == size_t(kNDccs) || n == EcalDenseIndex::kSizeForDenseIndexing) return;
+    throw cms::Exception("EcalSRSettingsTable") << name << " has " << n << " elements, expected 1, 2, "
+      << kNDccs << " or " << EcalDenseIndex::kSizeForDenseIndexing;
+  }
+
+  // the element of a setting which applies to a crystal
+  template <typename T>
+  const T& resolve(const std::vector<T>& v, const char* name, uint32_t denseIndex, int dcc) {
+    switch (v.size()) {
+      case 1:
+        return v[0];
+      case 2:
+        return v[denseIndex >= EcalDenseIndex::kEBSize];
+      case kNDccs:
+        if (dcc < 1 || dcc > kNDccs) {
+          throw cms::Exception("EcalSRSettingsTable") << name << " is given per DCC and crystal "
+            << EcalDenseIndex::toRawId(denseIndex) << " has no DCC in the electronics mapping";
+        }
+        return v[dcc - 1];
+      default:
+        return v[denseIndex];
+    }
+  }
+}
+
+int32_t EcalSRSettingsTable::hwWeight(float w) {
+  const long hw = std::lround(double(w) * kWeightScale);
+  return hw < kMinHwValue ? kMinHwValue : hw > kMaxHwValue ? kMaxHwValue : int32_t(hw);
+}
+
+int32_t EcalSRSettingsTable::hwThreshold(float thresholdGeV, float adcToGeV) {
+  const double thr = double(thresholdGeV) * kThresholdScale / adcToGeV;
+  if (thr >= kMaxHwValue + 0.5) return INT_MAX;
+  if (thr <= kMinHwValue - 0.5) return INT_MIN;
+  return int32_t(std::lround(thr));
+}
+
+EcalSRSettingsTable::EcalSRSettingsTable(const EcalSRSettings& settings, const EcalMappingElectronics& mapping) :
+  firstSample_(EcalDenseIndex::kSizeForDenseIndexing + 1, 0),
+  weightSet_(EcalDenseIndex::kSizeForDenseIndexing + 1, 0),
+  thresholdLow_(EcalDenseIndex::kSizeForDenseIndexing + 1, INT_MIN),
+  thresholdHigh_(EcalDenseIndex::kSizeForDenseIndexing + 1, INT_MIN),
+  symmetric_(EcalDenseIndex::kSizeForDenseIndexing + 1, 0),
+  dcc_(EcalDenseIndex::kSizeForDenseIndexing + 1, 0)
+{
+  checkLength(settings.ecalDccZs1stSample_, "ecalDccZs1stSample");
+  checkLength(settings.dccNormalizedWeights_, "dccNormalizedWeights");
+  checkLength(settings.symetricZS_, "symetricZS");
+  checkLength(settings.srpLowInterestChannelZS_, "srpLowInterestChannelZS");
+  checkLength(settings.srpHighInterestChannelZS_, "srpHighInterestChannelZS");
+  if (!(settings.ebDccAdcToGeV_ > 0) || !(settings.eeDccAdcToGeV_ > 0)) {
+    throw cms::Exception("EcalSRSettingsTable") << "invalid ADC to GeV factors " << settings.ebDccAdcToGeV_
+      << " (EB), " << settings.eeDccAdcToGeV_ << " (EE)";
+  }
+
+  // the weight sets in hardware representation, each stored once
+  std::vector<int32_t> slotOfSet(settings.dccNormalizedWeights_.size());
+  std::map<std::vector<int32_t>, int32_t> slots;
+  for (size_t i = 0; i < settings.dccNormalizedWeights_.size(); ++i) {
+    const std::vector<float>& w = settings.dccNormalizedWeights_[i];
+    if (w.size() != kNWeights) {
+      throw cms::Exception("EcalSRSettingsTable") << "dccNormalizedWeights[" << i << "] has " << w.size()
+        << " weights, expected " << kNWeights;
+    }
+    std::vector<int32_t> hw(kNWeights);
+    for (unsigned int k = 0; k < kNWeights; ++k) hw[k] = hwWeight(w[k]);
+    const std::pair<std::map<std::vector<int32_t>, int32_t>::iterator, bool> s =
+      slots.insert(std::make_pair(hw, int32_t(weightSets_.size())));
+    if (s.second) {
+      WeightSet set;
+      for (unsigned int k = 0; k < kNWeights; ++k) set.w[k] = hw[k];
+      weightSets_.push_back(set);
+    }
+    slotOfSet[i] = s.first->second;
+  }
+
+  for (uint32_t d = 0; d < EcalDenseIndex::kSizeForDenseIndexing; ++d) {
+    const int dcc = EcalElectronicsId(mapping.item(d).electronicsid).dccId();
+    dcc_[d] = dcc;
+    const int firstSample = resolve(settings.ecalDccZs1stSample_, "ecalDccZs1stSample", d, dcc);
+    if (firstSample < 1) {
+      throw cms::Exception("EcalSRSettingsTable") << "first ZS sample " << firstSample << " for crystal "
+        << EcalDenseIndex::toRawId(d) << ", samples are counted from 1";
+    }
+    firstSample_[d] = firstSample - 1;
+
+    // the index of the element of dccNormalizedWeights which applies
+    const std::vector<std::vector<float> >& sets = settings.dccNormalizedWeights_;
+    weightSet_[d] = slotOfSet[&resolve(sets, "dccNormalizedWeights", d, dcc) - &sets[0]];
+
+    const float adcToGeV = d < EcalDenseIndex::kEBSize ? settings.ebDccAdcToGeV_ : settings.eeDccAdcToGeV_;
+    thresholdLow_[d] = hwThreshold(resolve(settings.srpLowInterestChannelZS_, "srpLowInterestChannelZS", d, dcc), adcToGeV);
+    thresholdHigh_[d] = hwThreshold(resolve(settings.srpHighInterestChannelZS_, "srpHighInterestChannelZS", d, dcc), adcToGeV);
+    symmetric_[d] = resolve(settings.symetricZS_, "symetricZS", d, dcc) != 0 ? -1 : 0;
+  }
+}
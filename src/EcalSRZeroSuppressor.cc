@@ -0,0 +1,99 @@
+#include "CondFormats/EcalObjects/interface/EcalSRZeroSuppressor.h"
+#include "CondFormats/EcalObjects/interface/EcalSimd.h"
+
+#include <cstring>
+
+namespace {
+  const unsigned int kNWeights = EcalSRSettingsTable::kNWeights;
+
+  // sample used for the window positions beyond the frame: gain 12, ADC 0
+  const uint16_t kNoSample = 0x1000;
+
+  // FIR output from the raw samples of the window; also flags (-1) windows with a sample not at gain 12
+  template <typename VI>
+  inline VI firKernel(const VI* raw, const VI* w, VI symmetric, VI& notGain12) {
+    using namespace ecalsimd;
+    VI acc = splat<VI>(int32_t(0));
+    notGain12 = splat<VI>(int32_t(0));
+    for (unsigned int k = 0; k < kNWeights; ++k) {
+      acc += (raw[k] & 0xfff) * w[k];
+      notGain12 |= ~eq((raw[k] >> 12) & 3, splat<VI>(int32_t(1)));
+    }
+    const VI zero = splat<VI>(int32_t(0));
+    acc = selectInt(symmetric & lt(acc, zero), zero - acc, acc);
+    // 8 bits dropped, rounding down: offset to a positive value before the shift, as the emulator
+    return ((acc + (1 << 30)) >> 8) - (1 << 22);
+  }
+
+  // -1 for a kept frame
+  template <typename VI>
+  inline VI keepKernel(VI acc, VI notGain12, VI threshold) {
+    using namespace ecalsimd;
+    return ~lt(acc, threshold) | notGain12;
+  }
+
+  // the window of a frame, with its weights
+  inline void window(const EcalSRSettingsTable& table, uint32_t denseIndex, const uint16_t* frame, unsigned int nSamples,
+                     int32_t* raw, int32_t* w) {
+    const unsigned int first = table.firstSample(denseIndex);
+    const int32_t* weights = table.weights(table.weightSet(denseIndex));
+    for (unsigned int k = 0; k < kNWeights; ++k) {
+      raw[k] = first + k < nSamples ? frame[first + k] : kNoSample;
+      w[k] = weights[k];
+    }
+  }
+}
+
+int32_t EcalSRZeroSuppressor::filter(uint32_t denseIndex, const uint16_t* frame, unsigned int nSamples) const {
+  int32_t raw[kNWeights], w[kNWeights], notGain12;
+  window(*table_, denseIndex, frame, nSamples, raw, w);
+  return firKernel<int32_t>(raw, w, table_->symmetric(denseIndex) ? -1 : 0, notGain12);
+}
+
+bool EcalSRZeroSuppressor::accept(uint32_t denseIndex, const uint16_t* frame, unsigned int nSamples,
+                                  bool highInterest) const {
+  int32_t raw[kNWeights], w[kNWeights], notGain12;
+  window(*table_, denseIndex, frame, nSamples, raw, w);
+  const int32_t acc = firKernel<int32_t>(raw, w, table_->symmetric(denseIndex) ? -1 : 0, notGain12);
+  const int32_t threshold = highInterest ? table_->thresholdHigh(denseIndex) : table_->thresholdLow(denseIndex);
+  return keepKernel<int32_t>(acc, notGain12, threshold) != 0;
+}
+
+void EcalSRZeroSuppressor::run(size_t nFrames, unsigned int nSamples, const uint32_t* denseIndices,
+                               const uint16_t* samples, const uint8_t* highInterest, uint64_t* keep) const {
+  using namespace ecalsimd;
+  std::memset(keep, 0, (nFrames + 63) / 64 * sizeof(uint64_t));
+  const EcalSRSettingsTable::Column& symmetric = table_->symmetricMasks();
+  const EcalSRSettingsTable::Column& low = table_->thresholdsLow();
+  const EcalSRSettingsTable::Column& high = table_->thresholdsHigh();
+  const size_t nVec = nFrames / kLanes * kLanes;
+  for (size_t i = 0; i < nVec; i += kLanes) {
+    // gather the windows, weights and settings of the frames, one per lane
+    int32_t raw[kNWeights][kLanes], w[kNWeights][kLanes], sym[kLanes], thr[kLanes], out[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      const uint32_t d = denseIndices[i + l] < EcalDenseIndex::kSizeForDenseIndexing
+                           ? denseIndices[i + l] : EcalDenseIndex::kSizeForDenseIndexing;
+      int32_t r[kNWeights], c[kNWeights];
+      window(*table_, d, samples + (i + l) * nSamples, nSamples, r, c);
+      for (unsigned int k = 0; k < kNWeights; ++k) {
+        raw[k][l] = r[k];
+        w[k][l] = c[k];
+      }
+      sym[l] = symmetric[d];
+      thr[l] = highInterest[i + l] ? high[d] : low[d];
+    }
+    vint vraw[kNWeights], vw[kNWeights], notGain12;
+    for (unsigned int k = 0; k < kNWeights; ++k) {
+      vraw[k] = load<vint>(raw[k]);
+      vw[k] = load<vint>(w[k]);
+    }
+    const vint acc = firKernel<vint>(vraw, vw, load<vint>(sym), notGain12);
+    store(out, keepKernel<vint>(acc, notGain12, load<vint>(thr)));
+    for (int l = 0; l < kLanes; ++l) keep[(i + l) >> 6] |= uint64_t(out[l] & 1) << ((i + l) & 63);
+  }
+  for (size_t i = nVec; i < nFrames; ++i) {
+    if (accept(denseIndices[i], samples + i * nSamples, nSamples, highInterest[i] != 0)) {
+      keep[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+  }
+}
@@ -11,8 +11,8 @@
 EcalSampleMask::EcalSampleMask() 
 {
   // by default, all samples are set as active
-  sampleMaskEB_=pow(2, EcalDataFrame::MAXSAMPLES)-1;
-  sampleMaskEB_=pow(2, EcalDataFrame::MAXSAMPLES)-1;
+  sampleMaskEB_=(0x1 << EcalDataFrame::MAXSAMPLES)-1;
+  sampleMaskEE_=(0x1 << EcalDataFrame::MAXSAMPLES)-1;
 }
 
 
@@ -24,7 +24,7 @@ EcalSampleMask::EcalSampleMask(const unsigned int ebmask, const unsigned int eem
 
 EcalSampleMask::EcalSampleMask( const std::vector<unsigned int> &ebmask, const std::vector<unsigned int> &eemask) {
   setEcalSampleMaskRecordEB( ebmask );
-  setEcalSampleMaskRecordEB( eemask );
+  setEcalSampleMaskRecordEE( eemask );
 }
 
 
@@ -56,7 +56,7 @@ void EcalSampleMask::setEcalSampleMaskRecordEB( const std::vector<unsigned int>
   // ebmask.at(EcalDataFrame::MAXSAMPLES) refers to the last  sample read out and is mapped into the _least_ significant bit of sampleMaskEB_ 
   sampleMaskEB_=0;
   for (unsigned int sampleId=0; sampleId<ebmask.size(); sampleId++ ) {
-    sampleMaskEB_ |= (0x1 << (EcalDataFrame::MAXSAMPLES -(sampleId+1) ));
+    if ( ebmask.at(sampleId) ) sampleMaskEB_ |= (0x1 << (EcalDataFrame::MAXSAMPLES -(sampleId+1) ));
   }
 
 }
@@ -84,7 +84,7 @@ void EcalSampleMask::setEcalSampleMaskRecordEE( const std::vector<unsigned int>
   // eemask.at(EcalDataFrame::MAXSAMPLES) refers to the last  sample read out and is mapped into the _least_ significant bit of sampleMaskEE_ 
   sampleMaskEE_=0;
   for (unsigned int sampleId=0; sampleId<eemask.size(); sampleId++ ) {
-    sampleMaskEE_ |= (0x1 << (EcalDataFrame::MAXSAMPLES -(sampleId+1) ));
+    if ( eemask.at(sampleId) ) sampleMaskEE_ |= (0x1 << (EcalDataFrame::MAXSAMPLES -(sampleId+1) ));
   }
 
 }
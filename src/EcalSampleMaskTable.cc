@@ -0,0 +1,21 @@
+#include "CondFormats/EcalObjects/interface/EcalSampleMaskTable.h"
+#include "DataFormats/EcalDigi/interface/EcalDataFrame.h"
+
+const unsigned int EcalSampleMaskTable::kPaddedSamples;
+
+EcalSampleMaskTable::EcalSampleMaskTable(const EcalSampleMask& sampleMask) {
+  unpack(sampleMask.getEcalSampleMaskRecordEB(), samples_[0]);
+  unpack(sampleMask.getEcalSampleMaskRecordEE(), samples_[1]);
+}
+
+void EcalSampleMaskTable::unpack(unsigned int mask, Samples& samples) {
+  samples.mask = mask;
+  samples.nActive = 0;
+  for (unsigned int s = 0; s < kPaddedSamples; ++s) {
+    const bool on = s < unsigned(EcalDataFrame::MAXSAMPLES) && (mask & (0x1 << (EcalDataFrame::MAXSAMPLES - (s + 1))));
+    samples.active[s] = 0;
+    samples.blend[s] = on ? -1 : 0;
+    samples.weight[s] = on ? 1.f : 0.f;
+    if (on) samples.active[samples.nActive++] = s;
+  }
+}
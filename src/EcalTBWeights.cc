@@ -24,6 +24,7 @@ EcalTBWeights::setValue(const EcalXtalGroupId& groupId,
 
 void
 EcalTBWeights::setValue(const std::pair<EcalXtalGroupId,EcalTDCId >& keyPair, const EcalWeightSet& weight) {
-  map_.insert( std::make_pair(keyPair,weight) );
+  // overwrite the weights already there for the same key, as the other payloads do
+  map_[keyPair] = weight;
 }
 
@@ -0,0 +1,51 @@
+#include "CondFormats/EcalObjects/interface/EcalTBWeightsTable.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+
+const uint32_t EcalTBWeightsTable::kMaxTDCBins;
+
+EcalTBWeightsTable::EcalTBWeightsTable(const EcalTBWeights& weights, const EcalWeightXtalGroups* xtalGroups) :
+  firstTDC_(0),
+  nTDCBins_(0)
+{
+  const EcalTBWeights::EcalTBWeightMap& m = weights.getMap();
+  EcalTBWeights::EcalTBWeightMap::const_iterator it;
+
+  // the map is sorted on the group first: group ids come out in order
+  EcalTDCId lastTDC = 0;
+  for (it = m.begin(); it != m.end(); ++it) {
+    if (groupIds_.empty() || !(groupIds_.back() == it->first.first)) groupIds_.push_back(it->first.first);
+    if (it == m.begin() || it->first.second < firstTDC_) firstTDC_ = it->first.second;
+    if (it == m.begin() || it->first.second > lastTDC) lastTDC = it->first.second;
+  }
+  // in 64 bits, the span of two int TDC ids may not fit in an int
+  const int64_t span = m.empty() ? 0 : int64_t(lastTDC) - int64_t(firstTDC_) + 1;
+  if (span > int64_t(kMaxTDCBins)) {
+    throw cms::Exception("EcalTBWeightsTable") << "TDC ids " << firstTDC_ << " to " << lastTDC
+      << " span more than " << kMaxTDCBins << " bins";
+  }
+  nTDCBins_ = uint32_t(span);
+
+  table_.assign(groupIds_.size() * nTDCBins_, -1);
+  sets_.reserve(m.size());
+  int g = -1;
+  for (it = m.begin(); it != m.end(); ++it) {
+    if (g < 0 || !(groupIds_[g] == it->first.first)) ++g;
+    table_[g * nTDCBins_ + (uint32_t(it->first.second) - uint32_t(firstTDC_))] = int32_t(sets_.size());
+    sets_.push_back(it->second);
+  }
+
+  if (xtalGroups) {
+    xtalGroup_.resize(EcalDenseIndex::kSizeForDenseIndexing);
+    for (uint32_t i = 0; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+      xtalGroup_[i] = groupIndex(xtalGroups->item(i));
+    }
+  }
+}
+
+int EcalTBWeightsTable::groupIndex(const EcalXtalGroupId& groupId) const {
+  std::vector<EcalXtalGroupId>::const_iterator it = std::lower_bound(groupIds_.begin(), groupIds_.end(), groupId);
+  return it != groupIds_.end() && *it == groupId ? int(it - groupIds_.begin()) : -1;
+}
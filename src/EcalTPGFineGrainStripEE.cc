@@ -1,4 +1,5 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGFineGrainStripEE.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 EcalTPGFineGrainStripEE::EcalTPGFineGrainStripEE()
@@ -9,5 +10,8 @@ EcalTPGFineGrainStripEE::~EcalTPGFineGrainStripEE()
 
 void EcalTPGFineGrainStripEE::setValue(const uint32_t & id, const Item & value)
 {
+  if (flat_.built()) {
+    throw cms::Exception("EcalTPGFineGrainStripEE") << "setValue() after getFlatMap(), the payload is complete" ;
+  }
   map_[id] = value ;
 }
@@ -1,4 +1,5 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGFineGrainTowerEE.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 EcalTPGFineGrainTowerEE::EcalTPGFineGrainTowerEE()
@@ -9,5 +10,8 @@ EcalTPGFineGrainTowerEE::~EcalTPGFineGrainTowerEE()
 
 void EcalTPGFineGrainTowerEE::setValue(const uint32_t & id, const uint32_t & lut)
 {
+  if (flat_.built()) {
+    throw cms::Exception("EcalTPGFineGrainTowerEE") << "setValue() after getFlatMap(), the payload is complete" ;
+  }
   map_[id] = lut ;
 }
@@ -1,4 +1,5 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGGroups.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 EcalTPGGroups::EcalTPGGroups()
 { }
@@ -7,7 +8,10 @@ EcalTPGGroups::~EcalTPGGroups()
 { }
 
 void  EcalTPGGroups::setValue(const uint32_t & rawId, const   uint32_t & ObjectId)
-{ 
+{
+  if (flat_.built()) {
+    throw cms::Exception("EcalTPGGroups") << "setValue() after getFlatMap(), the payload is complete" ;
+  }
   map_[rawId] = ObjectId ;
 }
 
@@ -0,0 +1,79 @@
+#include "CondFormats/EcalObjects/interface/EcalTPGLinearizer.h"
+#include "CondFormats/EcalObjects/interface/EcalSimd.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+const int32_t EcalTPGLinearizer::kMaxOutput;
+const uint32_t EcalTPGLinearizer::kPedestalBits;
+const uint32_t EcalTPGLinearizer::kMultiplierBits;
+const uint32_t EcalTPGLinearizer::kShiftBits;
+const uint32_t EcalTPGLinearizer::kFenixShiftOffset;
+const uint32_t EcalTPGLinearizer::kSaturatedMultiplier;
+
+namespace {
+  uint32_t checked(uint32_t value, uint32_t bits, const char* what, uint32_t denseIndex) {
+    if (value >> bits) {
+      throw cms::Exception("EcalTPGLinearizer") << what << " " << value << " of crystal "
+        << EcalDenseIndex::toRawId(denseIndex) << " does not fit in " << bits << " bits";
+    }
+    return value;
+  }
+
+  template <typename VI>
+  inline VI linearizeKernel(VI sample, VI word) {
+    using namespace ecalsimd;
+    const VI adc = sample & 0xfff;
+    const VI pedestal = word & 0xfff;
+    const VI multiplier = (word >> 12) & 0xff;
+    const VI shift = (word >> 20) & 0xf;
+    VI v = ((adc - pedestal) * multiplier) >> shift;
+    v = selectInt(lt(v, splat<VI>(int32_t(0))), splat<VI>(int32_t(0)), v);
+    return selectInt(gt(v, splat<VI>(EcalTPGLinearizer::kMaxOutput)), splat<VI>(EcalTPGLinearizer::kMaxOutput), v);
+  }
+}
+
+EcalTPGLinearizer::EcalTPGLinearizer(const EcalTPGPedestals& pedestals, const EcalTPGLinearizationConst& linearization,
+                                     uint32_t shiftOffset) :
+  table_(4 * (EcalDenseIndex::kSizeForDenseIndexing + 1), 0)
+{
+  for (uint32_t i = 0; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+    const EcalTPGPedestal& p = pedestals.item(i);
+    const EcalTPGLinearizationConstant& l = linearization.item(i);
+    const uint32_t ped[3] = { p.mean_x12, p.mean_x6, p.mean_x1 };
+    const uint32_t mult[3] = { l.mult_x12, l.mult_x6, l.mult_x1 };
+    const uint32_t shift[3] = { l.shift_x12, l.shift_x6, l.shift_x1 };
+    for (int g = 0; g < 3; ++g) {
+      table_[entry(i, g + 1)] = pack(checked(ped[g], kPedestalBits, "pedestal", i),
+                                     checked(mult[g], kMultiplierBits, "multiplier", i),
+                                     checked(shift[g] + shiftOffset, kShiftBits, "shift", i));
+    }
+    // saturated samples: no pedestal, full multiplier, x1 shift
+    table_[entry(i, 0)] = pack(0, kSaturatedMultiplier, shift[2] + shiftOffset);
+  }
+}
+
+int32_t EcalTPGLinearizer::linearize(uint32_t denseIndex, uint16_t sample) const {
+  return linearizeKernel<int32_t>(sample, table_[entry(denseIndex, sample >> 12)]);
+}
+
+void EcalTPGLinearizer::linearize(size_t nFrames, unsigned int nSamples, const uint32_t* denseIndices,
+                                  const uint16_t* samples, int32_t* out) const {
+  using namespace ecalsimd;
+  const size_t n = nFrames * nSamples;
+  const size_t nVec = n / kLanes * kLanes;
+  size_t frame = 0;
+  unsigned int s = 0;
+  for (size_t i = 0; i < nVec; i += kLanes) {
+    // widen the samples and gather the words of their crystal and gain
+    int32_t x[kLanes], w[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      x[l] = samples[i + l];
+      w[l] = table_[entry(denseIndices[frame], x[l] >> 12)];
+      if (++s == nSamples) {
+        s = 0;
+        ++frame;
+      }
+    }
+    store(out + i, linearizeKernel<vint>(load<vint>(x), load<vint>(w)));
+  }
+  for (size_t i = nVec; i < n; ++i) out[i] = linearize(denseIndices[i / nSamples], samples[i]);
+}
@@ -1,12 +1,13 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGLut.h"
 
+#include <cstring>
+
 EcalTPGLut::EcalTPGLut()
 { }
 
 EcalTPGLut::EcalTPGLut(const EcalTPGLut & tpgLut)
 { 
-  const unsigned int * lut = tpgLut.getLut() ;
-  for (unsigned int i=0 ; i<1024 ; i++) lut_[i] = lut[i] ;
+  std::memcpy(lut_, tpgLut.getLut(), sizeof(lut_)) ;
 }
 
 EcalTPGLut::~EcalTPGLut()
@@ -19,11 +20,10 @@ const unsigned int * EcalTPGLut::getLut() const
 
 void EcalTPGLut::setLut(const unsigned int * lut) 
 {
-  for (unsigned int i=0 ; i<1024 ; i++) lut_[i] = lut[i] ;
+  if (lut != lut_) std::memcpy(lut_, lut, sizeof(lut_)) ;
 }
 
 EcalTPGLut & EcalTPGLut::operator=(const EcalTPGLut & tpgLut) {
-  const unsigned int * lut = tpgLut.getLut() ;
-  for (unsigned int i=0 ; i<1024 ; i++) lut_[i] = lut[i] ;
+  if (&tpgLut != this) std::memcpy(lut_, tpgLut.getLut(), sizeof(lut_)) ;
   return *this;
 }
@@ -0,0 +1,159 @@
+#include "CondFormats/EcalObjects/interface/EcalTPGLutPool.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGLutIdMap.h"
+
+#include <cstring>
+
+const unsigned int EcalTPGLutPool::kLutSize;
+
+namespace {
+  // the sentinel table: no stored entry, all equal to 0
+  template <typename Table>
+  Table emptyTable() {
+    Table t;
+    t.hash = 0;
+    t.offset = 0;
+    t.length = 0;
+    t.tail = 0;
+    t.refs = 0;
+    t.wide = false;
+    return t;
+  }
+}
+
+EcalTPGLutPool::EcalTPGLutPool() : tables_(1, emptyTable<Table>()), freedEntries_(0) {}
+
+EcalTPGLutPool::EcalTPGLutPool(const EcalTPGLutIdMap& lutMap) : tables_(1, emptyTable<Table>()), freedEntries_(0) {
+  const EcalTPGLutIdMap::EcalTPGLutMap& m = lutMap.getMap();
+  for (EcalTPGLutIdMap::EcalTPGLutMapItr it = m.begin(); it != m.end(); ++it) setLut(it->first, it->second.getLut());
+}
+
+uint64_t EcalTPGLutPool::hash(const unsigned int* lut) {
+  // FNV-1a over the 32 bit words
+  uint64_t h = 14695981039346656037ULL;
+  for (unsigned int i = 0; i < kLutSize; ++i) {
+    h ^= lut[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+size_t EcalTPGLutPool::add(const unsigned int* lut) {
+  const uint64_t h = hash(lut);
+  unsigned int stored[kLutSize];
+  std::pair<std::multimap<uint64_t, uint32_t>::const_iterator,
+            std::multimap<uint64_t, uint32_t>::const_iterator> range = byHash_.equal_range(h);
+  for (std::multimap<uint64_t, uint32_t>::const_iterator it = range.first; it != range.second; ++it) {
+    expand(it->second, stored);
+    if (std::memcmp(stored, lut, sizeof(stored)) == 0) return it->second;
+  }
+
+  Table t;
+  t.hash = h;
+  t.tail = lut[kLutSize - 1];
+  t.length = kLutSize;
+  while (t.length > 0 && lut[t.length - 1] == t.tail) --t.length;
+  t.refs = 0;
+  t.wide = false;
+  for (unsigned int i = 0; i < t.length; ++i) {
+    if (lut[i] > 0xffff) {
+      t.wide = true;
+      break;
+    }
+  }
+  if (t.wide) {
+    t.offset = wide_.size();
+    wide_.insert(wide_.end(), lut, lut + t.length);
+  } else {
+    t.offset = narrow_.size();
+    narrow_.insert(narrow_.end(), lut, lut + t.length);
+  }
+
+  size_t s;
+  if (freeSlots_.empty()) {
+    s = size();
+    tables_.back() = t;
+    tables_.push_back(emptyTable<Table>());
+  } else {
+    s = freeSlots_.back();
+    freeSlots_.pop_back();
+    tables_[s] = t;
+  }
+  byHash_.insert(std::make_pair(h, uint32_t(s)));
+  return s;
+}
+
+size_t EcalTPGLutPool::setLut(uint32_t lutId, const unsigned int* lut) {
+  const size_t s = add(lut);
+  ++tables_[s].refs;
+  std::pair<std::map<uint32_t, uint32_t>::iterator, bool> inserted = ids_.insert(std::make_pair(lutId, uint32_t(s)));
+  if (!inserted.second) {
+    const size_t old = inserted.first->second;
+    inserted.first->second = s;
+    release(old);
+  }
+  return s;
+}
+
+void EcalTPGLutPool::release(size_t slot) {
+  Table& t = tables_[slot];
+  if (--t.refs > 0) return;
+  std::pair<std::multimap<uint64_t, uint32_t>::iterator,
+            std::multimap<uint64_t, uint32_t>::iterator> range = byHash_.equal_range(t.hash);
+  for (std::multimap<uint64_t, uint32_t>::iterator it = range.first; it != range.second; ++it) {
+    if (it->second == slot) {
+      byHash_.erase(it);
+      break;
+    }
+  }
+  freedEntries_ += t.length;
+  t.length = 0;
+  freeSlots_.push_back(slot);
+  if (2 * freedEntries_ > narrow_.size() + wide_.size()) compact();
+}
+
+void EcalTPGLutPool::compact() {
+  std::vector<uint16_t> narrow;
+  std::vector<uint32_t> wide;
+  for (size_t s = 0; s < size(); ++s) {
+    Table& t = tables_[s];
+    if (t.refs == 0) {
+      t.offset = 0;
+      continue;
+    }
+    if (t.wide) {
+      const uint32_t offset = wide.size();
+      wide.insert(wide.end(), wide_.begin() + t.offset, wide_.begin() + t.offset + t.length);
+      t.offset = offset;
+    } else {
+      const uint32_t offset = narrow.size();
+      narrow.insert(narrow.end(), narrow_.begin() + t.offset, narrow_.begin() + t.offset + t.length);
+      t.offset = offset;
+    }
+  }
+  narrow_.swap(narrow);
+  wide_.swap(wide);
+  freedEntries_ = 0;
+}
+
+size_t EcalTPGLutPool::slot(uint32_t lutId) const {
+  std::map<uint32_t, uint32_t>::const_iterator it = ids_.find(lutId);
+  return it != ids_.end() ? it->second : size();
+}
+
+void EcalTPGLutPool::expand(size_t slot, unsigned int* out) const {
+  const Table& t = table(slot);
+  if (t.wide) {
+    std::memcpy(out, &wide_[0] + t.offset, t.length * sizeof(uint32_t));
+  } else {
+    for (unsigned int i = 0; i < t.length; ++i) out[i] = narrow_[t.offset + i];
+  }
+  for (unsigned int i = t.length; i < kLutSize; ++i) out[i] = t.tail;
+}
+
+EcalTPGLut EcalTPGLutPool::lut(size_t slot) const {
+  unsigned int table[kLutSize];
+  expand(slot, table);
+  EcalTPGLut l;
+  l.setLut(table);
+  return l;
+}
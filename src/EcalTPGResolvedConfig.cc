@@ -0,0 +1,99 @@
+#include "CondFormats/EcalObjects/interface/EcalTPGResolvedConfig.h"
+#include "DataFormats/EcalDetId/interface/EcalTrigTowerDetId.h"
+
+#include <map>
+
+const uint32_t EcalTPGResolvedConfig::kNone;
+const uint32_t EcalTPGResolvedConfig::kEETowerEtaMin;
+const uint32_t EcalTPGResolvedConfig::kEETowerEta;
+const uint32_t EcalTPGResolvedConfig::kEETowerPhi;
+const uint32_t EcalTPGResolvedConfig::kTowers;
+const uint32_t EcalTPGResolvedConfig::kStrips;
+
+namespace {
+  // distinct parameter sets, keyed by their values, mapped to their slot in the pool
+  typedef std::map<std::vector<uint32_t>, uint32_t> SlotMap;
+
+  std::vector<uint32_t> key(const EcalTPGWeights& w) {
+    std::vector<uint32_t> k(5);
+    w.getValues(k[0], k[1], k[2], k[3], k[4]);
+    return k;
+  }
+
+  std::vector<uint32_t> key(const EcalTPGFineGrainConstEB& fg) {
+    std::vector<uint32_t> k(5);
+    fg.getValues(k[0], k[1], k[2], k[3], k[4]);
+    return k;
+  }
+
+  // slot of every parameter id, the parameter sets stored once in pool
+  template <typename T>
+  std::map<uint32_t, uint32_t> pool(const std::map<uint32_t, T>& byId, std::vector<T>& pool) {
+    SlotMap slots;
+    std::map<uint32_t, uint32_t> idToSlot;
+    for (typename std::map<uint32_t, T>::const_iterator it = byId.begin(); it != byId.end(); ++it) {
+      std::pair<SlotMap::iterator, bool> s = slots.insert(std::make_pair(key(it->second), uint32_t(pool.size())));
+      if (s.second) pool.push_back(it->second);
+      idToSlot[it->first] = s.first->second;
+    }
+    return idToSlot;
+  }
+
+  uint32_t lookup(const std::map<uint32_t, uint32_t>& m, uint32_t id) {
+    std::map<uint32_t, uint32_t>::const_iterator it = m.find(id);
+    return it != m.end() ? it->second : EcalTPGResolvedConfig::kNone;
+  }
+}
+
+EcalTPGResolvedConfig::EcalTPGResolvedConfig(const EcalTPGLutGroup& lutGroup, const EcalTPGLutIdMap& luts,
+                                             const EcalTPGFineGrainEBGroup& fineGrainGroup,
+                                             const EcalTPGFineGrainEBIdMap& fineGrains,
+                                             const EcalTPGWeightGroup& weightGroup, const EcalTPGWeightIdMap& weights) :
+  luts_(luts)
+{
+  const std::map<uint32_t, uint32_t> fineGrainSlots = pool(fineGrains.getMap(), fineGrains_);
+  const std::map<uint32_t, uint32_t> weightSlots = pool(weights.getMap(), weights_);
+
+  const EcalTPGGroups::EcalTPGGroupsMap& lutTowers = lutGroup.getMap();
+  const EcalTPGGroups::EcalTPGGroupsMap& fineGrainTowers = fineGrainGroup.getMap();
+  const Tower none = { kNone, kNone };
+  towers_.assign(kTowers + 1, none);
+  for (EcalTPGGroups::EcalTPGGroupsMapItr it = lutTowers.begin(); it != lutTowers.end(); ++it) {
+    const uint32_t i = towerIndex(it->first);
+    const size_t slot = luts_.slot(it->second);
+    if (i < kTowers) towers_[i].lut = slot < luts_.size() ? slot : kNone;
+  }
+  for (EcalTPGGroups::EcalTPGGroupsMapItr it = fineGrainTowers.begin(); it != fineGrainTowers.end(); ++it) {
+    const uint32_t i = towerIndex(it->first);
+    if (i < kTowers) towers_[i].fineGrain = lookup(fineGrainSlots, it->second);
+  }
+
+  stripWeights_.assign(kStrips + 1, kNone);
+  const EcalTPGGroups::EcalTPGGroupsMap& weightStrips = weightGroup.getMap();
+  for (EcalTPGGroups::EcalTPGGroupsMapItr it = weightStrips.begin(); it != weightStrips.end(); ++it) {
+    const uint32_t i = stripIndex(it->first);
+    if (i < kStrips) stripWeights_[i] = lookup(weightSlots, it->second);
+  }
+}
+
+uint32_t EcalTPGResolvedConfig::towerIndex(uint32_t ttRawId) {
+  const uint32_t i = EcalTowerLattice::towerIndex(ttRawId);
+  if (i < EcalTowerLattice::kEBSize) return i;
+  const DetId id(ttRawId);
+  if (id.det() != DetId::Ecal || id.subdetId() != EcalTriggerTower) return kNone;
+  const EcalTrigTowerDetId tt(ttRawId);
+  const uint32_t eta = tt.ietaAbs() - kEETowerEtaMin, phi = tt.iphi() - 1;
+  return tt.subDet() == EcalEndcap && eta < kEETowerEta && phi < kEETowerPhi
+    ? EcalTowerLattice::kEBSize + ((tt.zside() > 0) * kEETowerEta + eta) * kEETowerPhi + phi : kNone;
+}
+
+uint32_t EcalTPGResolvedConfig::stripIndex(uint32_t stripId) {
+  // the strip ids of EcalTPGWeightGroup are EcalTriggerElectronicsId raw ids with the channel
+  // bits (0 to 2) cleared, decoded here from the bits: the id constructor rejects channel 0.
+  // Only the pseudo strip (bits 3 to 5), tower (6 to 12) and TCC (13 to 19) fields may be set
+  if ((stripId & ~0xffff8u) != 0) return kNone;
+  const uint32_t t = EcalMappingElectronicsIndex::triggerTowerIndex((stripId >> 13) & 0x7f, (stripId >> 6) & 0x7f);
+  const uint32_t s = ((stripId >> 3) & 0x7) - 1;
+  if (t == EcalMappingElectronicsIndex::kTriggerSize || s >= EcalMappingElectronicsIndex::kStrips) return kNone;
+  return t * EcalMappingElectronicsIndex::kStrips + s;
+}
@@ -1,4 +1,5 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGSlidingWindow.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 EcalTPGSlidingWindow::EcalTPGSlidingWindow()
@@ -9,5 +10,8 @@ EcalTPGSlidingWindow::~EcalTPGSlidingWindow()
 
 void EcalTPGSlidingWindow::setValue(const uint32_t & id, const uint32_t & value)
 {
+  if (flat_.built()) {
+    throw cms::Exception("EcalTPGSlidingWindow") << "setValue() after getFlatMap(), the payload is complete" ;
+  }
   map_[id] = value ;
 }
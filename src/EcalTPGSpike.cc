@@ -1,4 +1,5 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGSpike.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 EcalTPGSpike::EcalTPGSpike()
@@ -9,5 +10,8 @@ EcalTPGSpike::~EcalTPGSpike()
 
 void EcalTPGSpike::setValue(const uint32_t & id, const uint16_t & val)
 {
+  if (flat_.built()) {
+    throw cms::Exception("EcalTPGSpike") << "setValue() after getFlatMap(), the payload is complete" ;
+  }
   map_[id] = val ;
 }
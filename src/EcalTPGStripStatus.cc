@@ -1,4 +1,5 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGStripStatus.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 EcalTPGStripStatus::EcalTPGStripStatus()
@@ -9,5 +10,8 @@ EcalTPGStripStatus::~EcalTPGStripStatus()
 
 void EcalTPGStripStatus::setValue(const uint32_t & id, const uint16_t & val)
 {
+  if (flat_.built()) {
+    throw cms::Exception("EcalTPGStripStatus") << "setValue() after getFlatMap(), the payload is complete" ;
+  }
   map_[id] = val ;
 }
@@ -1,4 +1,5 @@
 #include "CondFormats/EcalObjects/interface/EcalTPGTowerStatus.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 EcalTPGTowerStatus::EcalTPGTowerStatus()
@@ -9,5 +10,8 @@ EcalTPGTowerStatus::~EcalTPGTowerStatus()
 
 void EcalTPGTowerStatus::setValue(const uint32_t & id, const uint16_t & val)
 {
+  if (flat_.built()) {
+    throw cms::Exception("EcalTPGTowerStatus") << "setValue() after getFlatMap(), the payload is complete" ;
+  }
   map_[id] = val ;
 }
@@ -0,0 +1,106 @@
+#include "CondFormats/EcalObjects/interface/EcalTemperatureSeries.h"
+#include "CondFormats/EcalObjects/interface/EcalSimd.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <limits>
+
+const size_t EcalTemperatureSeries::npos;
+
+EcalTemperatureSeries::EcalTemperatureSeries(const std::vector<uint32_t>& sensorIds) : stride_(0) {
+  setSensors(sensorIds);
+}
+
+void EcalTemperatureSeries::setSensors(std::vector<uint32_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  ids_.swap(ids);
+  stride_ = (ids_.size() + ecalsimd::kLanes - 1) / ecalsimd::kLanes * ecalsimd::kLanes;
+}
+
+void EcalTemperatureSeries::add(edm::Timestamp t, const std::map<uint32_t, float>& temperatures) {
+  if (!times_.empty() && t.value() <= times_.back()) {
+    throw cms::Exception("EcalTemperatureSeries") << "snapshot at time " << t.value()
+      << " is not later than the last one, " << times_.back();
+  }
+  if (times_.empty() && ids_.empty()) {
+    std::vector<uint32_t> ids;
+    for (std::map<uint32_t, float>::const_iterator it = temperatures.begin(); it != temperatures.end(); ++it) {
+      ids.push_back(it->first);
+    }
+    setSensors(ids);
+  }
+
+  // both sorted by id: one merge pass
+  const size_t row = values_.size();
+  values_.resize(row + stride_, std::numeric_limits<float>::quiet_NaN());
+  size_t i = 0;
+  for (std::map<uint32_t, float>::const_iterator it = temperatures.begin(); it != temperatures.end(); ++it) {
+    while (i < ids_.size() && ids_[i] < it->first) ++i;
+    if (i == ids_.size() || ids_[i] != it->first) {
+      values_.resize(row);
+      throw cms::Exception("EcalTemperatureSeries") << "sensor " << it->first << " is not in the series";
+    }
+    values_[row + i] = it->second;
+  }
+  times_.push_back(t.value());
+}
+
+size_t EcalTemperatureSeries::sensorIndex(uint32_t sensorId) const {
+  const std::vector<uint32_t>::const_iterator it = std::lower_bound(ids_.begin(), ids_.end(), sensorId);
+  return it != ids_.end() && *it == sensorId ? size_t(it - ids_.begin()) : npos;
+}
+
+void EcalTemperatureSeries::bracket(edm::Timestamp t, size_t& i, float& weight) const {
+  const size_t after = std::upper_bound(times_.begin(), times_.end(), t.value()) - times_.begin();
+  if (after == 0) {
+    i = 0;
+    weight = 0.f;
+  } else if (after == times_.size()) {
+    i = after - 1;
+    weight = 0.f;
+  } else {
+    i = after - 1;
+    weight = float(double(t.value() - times_[i]) / double(times_[after] - times_[i]));
+  }
+}
+
+void EcalTemperatureSeries::interpolate(edm::Timestamp t, float* out) const {
+  using namespace ecalsimd;
+  const size_t n = ids_.size();
+  if (times_.empty() || n == 0) {
+    std::fill(out, out + n, std::numeric_limits<float>::quiet_NaN());
+    return;
+  }
+  size_t s;
+  float weight;
+  bracket(t, s, weight);
+  const float* a = snapshot(s);
+  if (weight == 0.f) {
+    std::copy(a, a + n, out);
+    return;
+  }
+  const float* b = snapshot(s + 1);
+  const vfloat w = splat<vfloat>(weight);
+  const size_t nVec = n / kLanes * kLanes;
+  for (size_t i = 0; i < nVec; i += kLanes) {
+    const vfloat va = load<vfloat>(a + i);
+    store(out + i, va + w * (load<vfloat>(b + i) - va));
+  }
+  for (size_t i = nVec; i < n; ++i) out[i] = a[i] + weight * (b[i] - a[i]);
+}
+
+void EcalTemperatureSeries::interpolate(edm::Timestamp t, std::vector<float>& out) const {
+  out.resize(ids_.size());
+  if (!out.empty()) interpolate(t, &out[0]);
+}
+
+float EcalTemperatureSeries::value(uint32_t sensorId, edm::Timestamp t) const {
+  const size_t k = sensorIndex(sensorId);
+  if (k == npos || times_.empty()) return std::numeric_limits<float>::quiet_NaN();
+  size_t s;
+  float weight;
+  bracket(t, s, weight);
+  const float a = snapshot(s)[k];
+  return weight == 0.f ? a : a + weight * (snapshot(s + 1)[k] - a);
+}
@@ -0,0 +1,44 @@
+#include "CondFormats/EcalObjects/interface/EcalTowerStatusLattice.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+
+const uint32_t EcalTowerLattice::kEBEta;
+const uint32_t EcalTowerLattice::kEBPhi;
+const uint32_t EcalTowerLattice::kEBSize;
+const uint32_t EcalTowerLattice::kEESide;
+const uint32_t EcalTowerLattice::kEESize;
+const uint32_t EcalTowerLattice::kSize;
+
+uint32_t EcalTowerLattice::towerIndex(uint32_t rawId) {
+  const DetId id(rawId);
+  if (id.det() != DetId::Ecal) return kSize;
+  if (id.subdetId() == EcalTriggerTower || id.subdetId() == EcalBarrel) {
+    const EcalTrigTowerDetId tt(rawId);
+    return tt.subDet() == EcalBarrel ? barrelIndex(tt.ieta(), tt.iphi()) : kSize;
+  }
+  if (id.subdetId() == EcalEndcap) {
+    const EcalScDetId sc(rawId);
+    return endcapIndex(sc.ix(), sc.iy(), sc.zside());
+  }
+  return kSize;
+}
+
+namespace {
+  std::vector<uint16_t> makeCrystalTowers() {
+    std::vector<uint16_t> map(EcalDenseIndex::kSizeForDenseIndexing + 1, EcalTowerLattice::kSize);
+    for (uint32_t i = 0; i < EcalDenseIndex::kEBSize; ++i) {
+      const EBDetId id(EcalDenseIndex::toRawId(i));
+      map[i] = EcalTowerLattice::barrelIndex(id.tower_ieta(), id.tower_iphi());
+    }
+    for (uint32_t i = EcalDenseIndex::kEBSize; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) {
+      const EcalScDetId sc = EEDetId(EcalDenseIndex::toRawId(i)).sc();
+      map[i] = EcalTowerLattice::endcapIndex(sc.ix(), sc.iy(), sc.zside());
+    }
+    return map;
+  }
+}
+
+const std::vector<uint16_t>& EcalTowerLattice::crystalTowers() {
+  static const std::vector<uint16_t> map = makeCrystalTowers();
+  return map;
+}
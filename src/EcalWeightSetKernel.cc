@@ -0,0 +1,89 @@
+#include "CondFormats/EcalObjects/interface/EcalWeightSetKernel.h"
+#include "CondFormats/EcalObjects/interface/EcalSimd.h"
+
+
+const unsigned int EcalWeightSetKernel::kSamples;
+const unsigned int EcalWeightSetKernel::kParams;
+
+namespace {
+  const unsigned int kSamples = EcalWeightSetKernel::kSamples;
+  const unsigned int kParams = EcalWeightSetKernel::kParams;
+
+  // sums with one set of weights
+  template <typename VD>
+  inline void block(const VD* x, const double (*w)[kParams], const double (*c)[kSamples], VD* p, VD* chi2) {
+    using namespace ecalsimd;
+    for (unsigned int k = 0; k < kParams; ++k) {
+      VD sum = splat<VD>(0.);
+      for (unsigned int s = 0; s < kSamples; ++s) sum = sum + x[s] * w[s][k];
+      p[k] = sum;
+    }
+    if (!chi2) return;
+    VD sum = splat<VD>(0.);
+    for (unsigned int t = 0; t < kSamples; ++t) {
+      VD y = splat<VD>(0.);
+      for (unsigned int s = 0; s < kSamples; ++s) y = y + x[s] * c[t][s];
+      sum = sum + y * x[t];
+    }
+    *chi2 = sum;
+  }
+}
+
+EcalWeightSetKernel::EcalWeightSetKernel(const EcalWeightSet& weights) {
+  const EcalWeightSet::EcalWeightMatrix* w[2] = { &weights.getWeightsBeforeGainSwitch(),
+                                                  &weights.getWeightsAfterGainSwitch() };
+  const EcalWeightSet::EcalChi2WeightMatrix* c[2] = { &weights.getChi2WeightsBeforeGainSwitch(),
+                                                      &weights.getChi2WeightsAfterGainSwitch() };
+  for (int g = 0; g < 2; ++g) {
+    for (unsigned int s = 0; s < kSamples; ++s) {
+      for (unsigned int k = 0; k < kParams; ++k) weights_[g][s][k] = (*w[g])(k, s);
+      for (unsigned int t = 0; t < kSamples; ++t) chi2Weights_[g][t][s] = (*c[g])(s, t);
+    }
+  }
+}
+
+int EcalWeightSetKernel::simdWidth() {
+  return ecalsimd::kDoubleLanes;
+}
+
+void EcalWeightSetKernel::compute(const float* frame, bool gainSwitched, float* params, float* chi2) const {
+  double x[kSamples], p[kParams], c;
+  for (unsigned int s = 0; s < kSamples; ++s) x[s] = frame[s];
+  const int g = gainSwitched ? 1 : 0;
+  block<double>(x, weights_[g], chi2Weights_[g], p, chi2 ? &c : 0);
+  for (unsigned int k = 0; k < kParams; ++k) params[k] = float(p[k]);
+  if (chi2) *chi2 = float(c);
+}
+
+void EcalWeightSetKernel::compute(size_t n, const float* frames, const uint8_t* gainSwitched,
+                                  float* params, float* chi2) const {
+  using namespace ecalsimd;
+  const int kL = kDoubleLanes;
+  for (size_t i = 0; i < n; i += kL) {
+    // transpose the block, the lanes past the last frame see empty frames
+    const size_t m = n - i < size_t(kL) ? n - i : size_t(kL);
+    double xs[kSamples][kL];
+    int gain[kL];
+    bool anySwitched = false;
+    for (size_t l = 0; l < size_t(kL); ++l) {
+      const float* f = frames + (i + l) * kSamples;
+      for (unsigned int s = 0; s < kSamples; ++s) xs[s][l] = l < m ? f[s] : 0.;
+      gain[l] = l < m && gainSwitched && gainSwitched[i + l] ? 1 : 0;
+      anySwitched = anySwitched || gain[l];
+    }
+    vdouble x[kSamples];
+    for (unsigned int s = 0; s < kSamples; ++s) x[s] = load<vdouble>(xs[s]);
+
+    double ps[2][kParams][kL], cs[2][kL];
+    for (int g = 0; g < (anySwitched ? 2 : 1); ++g) {
+      vdouble p[kParams], c;
+      block<vdouble>(x, weights_[g], chi2Weights_[g], p, chi2 ? &c : 0);
+      for (unsigned int k = 0; k < kParams; ++k) store(ps[g][k], p[k]);
+      if (chi2) store(cs[g], c);
+    }
+    for (size_t l = 0; l < m; ++l) {
+      for (unsigned int k = 0; k < kParams; ++k) params[(i + l) * kParams + k] = float(ps[gain[l]][k][l]);
+      if (chi2) chi2[i + l] = float(cs[gain[l]][l]);
+    }
+  }
+}
@@ -0,0 +1,308 @@
+// Micro-benchmarks of the access patterns of the ECAL condition containers,
+// without database: EcalCondObjectContainer, EcalCondTowerObjectContainer,
+// the std::map based TPG payloads (groups, tower and strip status) with
+// their EcalFlatMap twins, and EcalTBWeights.
+//
+//   EcalObjectsBenchmark [--filter=substring] [--min-time=seconds]
+//
+// Each benchmark is repeated until it has run for min-time (default 0.2 s).
+// One JSON object per line is written to stdout:
+//   {"name":"...","iterations":N,"ops":M,"ns_per_op":x,"bytes":b}
+// where ops is the number of accesses per iteration and bytes the memory
+// footprint of the object the benchmark works on (heap nodes of the maps
+// are estimated from their element count; the flat map benchmarks count
+// the arrays of the flat map only, not the std::map it is built from).
+
+#include "CondFormats/EcalObjects/interface/EcalCondObjectContainer.h"
+#include "CondFormats/EcalObjects/interface/EcalCondTowerObjectContainer.h"
+#include "CondFormats/EcalObjects/interface/EcalDenseIndex.h"
+#include "CondFormats/EcalObjects/interface/EcalTBWeights.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGLutGroup.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGStripStatus.h"
+#include "CondFormats/EcalObjects/interface/EcalTPGTowerStatus.h"
+#include "DataFormats/EcalDetId/interface/EcalScDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalTrigTowerDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalTriggerElectronicsId.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  std::string filter;
+  double minTime = 0.2;
+  volatile double sink = 0;
+
+  // per node overhead of a std::map (colour, parent, left, right)
+  const size_t kMapNode = 32;
+
+  template <typename F>
+  void run(const std::string& name, size_t ops, size_t bytes, F f) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+    typedef std::chrono::steady_clock Clock;
+    f();  // warm up
+    size_t iterations = 0;
+    double elapsed = 0;
+    const Clock::time_point t0 = Clock::now();
+    do {
+      f();
+      ++iterations;
+      elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+    } while (elapsed < minTime);
+    std::printf("{\"name\":\"%s\",\"iterations\":%zu,\"ops\":%zu,\"ns_per_op\":%.3f,\"bytes\":%zu}\n",
+                name.c_str(), iterations, ops, 1e9 * elapsed / (double(iterations) * ops), bytes);
+    std::fflush(stdout);
+  }
+
+  template <typename C>
+  size_t containerBytes(const C& c) {
+    return sizeof(C) + (c.barrelItems().capacity() + c.endcapItems().capacity()) * sizeof(typename C::Item);
+  }
+
+  template <typename K, typename V>
+  size_t mapBytes(const std::map<K, V>& m) {
+    return sizeof(m) + m.size() * (kMapNode + sizeof(typename std::map<K, V>::value_type));
+  }
+
+  template <typename K, typename V>
+  size_t flatMapBytes(const EcalFlatMap<K, V>& m) {
+    // sorted pairs, plus the Eytzinger keys and positions (one unused slot each)
+    return sizeof(m) + m.items().capacity() * sizeof(typename EcalFlatMap<K, V>::value_type) +
+           (m.size() + 1) * (sizeof(K) + sizeof(uint32_t));
+  }
+
+  // the same ids in their natural and in a fixed random order
+  struct Ids {
+    std::vector<uint32_t> sequential, random;
+    void shuffle() {
+      random = sequential;
+      std::mt19937 rng(12345);
+      std::shuffle(random.begin(), random.end(), rng);
+    }
+  };
+
+  template <typename C>
+  void benchContainer(const std::string& prefix, const Ids& ids, const C& c) {
+    const size_t n = ids.sequential.size(), bytes = containerBytes(c);
+    run(prefix + "/operator[]/sequential", n, bytes, [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += c[ids.sequential[i]];
+      sink = s;
+    });
+    run(prefix + "/operator[]/random", n, bytes, [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += c[ids.random[i]];
+      sink = s;
+    });
+    run(prefix + "/find/sequential", n, bytes, [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += *c.find(ids.sequential[i]);
+      sink = s;
+    });
+    run(prefix + "/find/random", n, bytes, [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += *c.find(ids.random[i]);
+      sink = s;
+    });
+    run(prefix + "/iterate", n, bytes, [&] {
+      double s = 0;
+      for (typename C::Items::const_iterator it = c.barrelItems().begin(); it != c.barrelItems().end(); ++it) s += *it;
+      for (typename C::Items::const_iterator it = c.endcapItems().begin(); it != c.endcapItems().end(); ++it) s += *it;
+      sink = s;
+    });
+    run(prefix + "/setValue", n, bytes, [&] {
+      C fresh;
+      for (size_t i = 0; i < n; ++i) fresh.setValue(ids.sequential[i], float(i));
+      sink = fresh.size();
+    });
+    run(prefix + "/copy", n, bytes, [&] {
+      C copy(c);
+      sink = copy.size();
+    });
+  }
+
+  void benchCrystals() {
+    Ids ids;
+    for (uint32_t i = 0; i < EcalDenseIndex::kSizeForDenseIndexing; ++i) ids.sequential.push_back(EcalDenseIndex::toRawId(i));
+    ids.shuffle();
+    EcalFloatCondObjectContainer c;
+    for (size_t i = 0; i < ids.sequential.size(); ++i) c.setValue(ids.sequential[i], 1.f + i % 7);
+    benchContainer("EcalCondObjectContainer<float>", ids, c);
+
+    const size_t n = ids.sequential.size();
+    std::vector<float> dense(c.barrelItems());
+    dense.insert(dense.end(), c.endcapItems().begin(), c.endcapItems().end());
+    run("EcalCondObjectContainer<float>/fill", n, containerBytes(c), [&] {
+      EcalFloatCondObjectContainer fresh;
+      fresh.fill(&dense[0], dense.size());
+      sink = fresh.size();
+    });
+    run("EcalCondObjectContainer<float>/generate", n, containerBytes(c), [&] {
+      EcalFloatCondObjectContainer fresh;
+      fresh.generate([&](size_t i) { return dense[i]; });
+      sink = fresh.size();
+    });
+  }
+
+  void benchTowers() {
+    Ids ids;
+    for (int i = 0; i < EcalTrigTowerDetId::kEBTotalTowers; ++i) {
+      ids.sequential.push_back(EcalTrigTowerDetId::detIdFromDenseIndex(i).rawId());
+    }
+    for (int i = 0; i < EcalScDetId::kSizeForDenseIndexing; ++i) {
+      if (EcalScDetId::validHashIndex(i)) ids.sequential.push_back(EcalScDetId::unhashIndex(i).rawId());
+    }
+    ids.shuffle();
+    EcalCondTowerObjectContainer<float> c;
+    for (size_t i = 0; i < ids.sequential.size(); ++i) c.setValue(ids.sequential[i], 1.f + i % 7);
+    benchContainer("EcalCondTowerObjectContainer<float>", ids, c);
+  }
+
+  void benchTPGGroups() {
+    // the LUT group of the EB trigger towers, keyed by raw id as in the TPG payloads
+    Ids ids;
+    for (int i = 0; i < EcalTrigTowerDetId::kEBTotalTowers; ++i) {
+      ids.sequential.push_back(EcalTrigTowerDetId::detIdFromDenseIndex(i).rawId());
+    }
+    ids.shuffle();
+    EcalTPGLutGroup g;
+    for (size_t i = 0; i < ids.sequential.size(); ++i) g.setValue(ids.sequential[i], i % 3);
+    const size_t n = ids.sequential.size(), bytes = mapBytes(g.getMap());
+
+    run("EcalTPGLutGroup/find/sequential", n, bytes, [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += g.getMap().find(ids.sequential[i])->second;
+      sink = s;
+    });
+    run("EcalTPGLutGroup/find/random", n, bytes, [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += g.getMap().find(ids.random[i])->second;
+      sink = s;
+    });
+    const EcalFlatMap<uint32_t, uint32_t>& flat = g.getFlatMap();
+    run("EcalTPGLutGroup/flatMap/find/random", n, flatMapBytes(flat), [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += flat.find(ids.random[i])->second;
+      sink = s;
+    });
+    run("EcalTPGLutGroup/iterate", n, bytes, [&] {
+      double s = 0;
+      for (EcalTPGGroups::EcalTPGGroupsMapItr it = g.getMap().begin(); it != g.getMap().end(); ++it) s += it->second;
+      sink = s;
+    });
+    run("EcalTPGLutGroup/setValue", n, bytes, [&] {
+      EcalTPGLutGroup fresh;
+      for (size_t i = 0; i < n; ++i) fresh.setValue(ids.sequential[i], i % 3);
+      sink = fresh.getMap().size();
+    });
+    run("EcalTPGLutGroup/copy", n, bytes, [&] {
+      EcalTPGLutGroup copy(g);
+      sink = copy.getMap().size();
+    });
+  }
+
+  // lookups in the std::map of a status payload and in its flat map
+  template <typename P>
+  void benchStatus(const std::string& prefix, const Ids& ids) {
+    P p;
+    for (size_t i = 0; i < ids.sequential.size(); ++i) p.setValue(ids.sequential[i], i % 2);
+    const size_t n = ids.sequential.size();
+    const EcalFlatMap<uint32_t, uint16_t>& flat = p.getFlatMap();
+
+    run(prefix + "/find/random", n, mapBytes(p.getMap()), [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += p.getMap().find(ids.random[i])->second;
+      sink = s;
+    });
+    run(prefix + "/flatMap/find/random", n, flatMapBytes(flat), [&] {
+      double s = 0;
+      for (size_t i = 0; i < n; ++i) s += flat.find(ids.random[i])->second;
+      sink = s;
+    });
+  }
+
+  void benchTPGStatus() {
+    // tower keyed: the EB trigger towers
+    Ids towers;
+    for (int i = 0; i < EcalTrigTowerDetId::kEBTotalTowers; ++i) {
+      towers.sequential.push_back(EcalTrigTowerDetId::detIdFromDenseIndex(i).rawId());
+    }
+    towers.shuffle();
+    benchStatus<EcalTPGTowerStatus>("EcalTPGTowerStatus", towers);
+
+    // strip keyed: every (TCC, trigger tower, pseudo strip), with the channel bits cleared
+    // (the id constructor rejects channel 0)
+    Ids strips;
+    for (int tcc = 1; tcc <= 108; ++tcc) {
+      for (int tt = 1; tt <= 68; ++tt) {
+        for (int ps = 1; ps <= 5; ++ps) {
+          strips.sequential.push_back(EcalTriggerElectronicsId(tcc, tt, ps, 1).rawId() & ~0x7u);
+        }
+      }
+    }
+    strips.shuffle();
+    benchStatus<EcalTPGStripStatus>("EcalTPGStripStatus", strips);
+  }
+
+  void benchTBWeights() {
+    // a few crystal groups, each with a weight set per TDC bin
+    const int nGroups = 4, nTDC = 50;
+    std::vector<std::pair<EcalXtalGroupId, EcalTBWeights::EcalTDCId> > keys;
+    for (int g = 1; g <= nGroups; ++g) {
+      for (int t = 1; t <= nTDC; ++t) keys.push_back(std::make_pair(EcalXtalGroupId(g), t));
+    }
+    std::vector<std::pair<EcalXtalGroupId, EcalTBWeights::EcalTDCId> > random(keys);
+    std::mt19937 rng(12345);
+    std::shuffle(random.begin(), random.end(), rng);
+    EcalTBWeights w;
+    for (size_t i = 0; i < keys.size(); ++i) w.setValue(keys[i], EcalWeightSet());
+    const size_t n = keys.size(), bytes = mapBytes(w.getMap());
+
+    run("EcalTBWeights/find/random", n, bytes, [&] {
+      size_t s = 0;
+      for (size_t i = 0; i < n; ++i) s += w.getMap().find(random[i]) != w.getMap().end();
+      sink = s;
+    });
+    run("EcalTBWeights/iterate", n, bytes, [&] {
+      size_t s = 0;
+      for (EcalTBWeights::EcalTBWeightMap::const_iterator it = w.getMap().begin(); it != w.getMap().end(); ++it) {
+        s += it->first.second;
+      }
+      sink = s;
+    });
+    run("EcalTBWeights/setValue", n, bytes, [&] {
+      EcalTBWeights fresh;
+      for (size_t i = 0; i < n; ++i) fresh.setValue(keys[i], EcalWeightSet());
+      sink = fresh.getMap().size();
+    });
+    run("EcalTBWeights/copy", n, bytes, [&] {
+      EcalTBWeights copy(w);
+      sink = copy.getMap().size();
+    });
+  }
+}
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+      filter = argv[i] + 9;
+    } else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+      minTime = std::atof(argv[i] + 11);
+    } else {
+      std::fprintf(stderr, "usage: %s [--filter=substring] [--min-time=seconds]\n", argv[0]);
+      return 1;
+    }
+  }
+  benchCrystals();
+  benchTowers();
+  benchTPGGroups();
+  benchTPGStatus();
+  benchTBWeights();
+  return 0;
+}
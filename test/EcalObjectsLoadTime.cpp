@@ -0,0 +1,73 @@
+// Measures what loading the CondFormats/EcalObjects library costs a job:
+// the time spent in dlopen (static initialisation included: dictionaries
+// and TYPELOOKUP_DATA_REG registrations) and the resident memory it adds.
+//
+//   EcalObjectsLoadTime [library] [type name ...]
+//
+// The library defaults to libCondFormatsEcalObjects.so, found through
+// LD_LIBRARY_PATH. The type names (default EcalPedestals) are looked up
+// in the EventSetup type registry after the load, to check and time the
+// registrations. One load per process: run it several times for spread.
+// The output is one "key value" pair per line. Fails if the library is
+// already loaded at startup (linked in), the measurement being void then.
+
+#include "FWCore/Utilities/interface/typelookup.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+namespace {
+  long residentKb() {
+    long pages = 0, resident = 0;
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return -1;
+    if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = -1;
+    std::fclose(f);
+    return resident < 0 ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+  }
+
+  double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+  }
+}
+
+int main(int argc, char** argv) {
+  const std::string library = argc > 1 ? argv[1] : "libCondFormatsEcalObjects.so";
+  std::vector<std::string> types(argv + (argc > 2 ? 2 : argc), argv + argc);
+  if (types.empty()) types.push_back("EcalPedestals");
+
+  if (dlopen(library.c_str(), RTLD_NOW | RTLD_NOLOAD)) {
+    std::fprintf(stderr, "%s is already loaded, nothing to measure\n", library.c_str());
+    return 1;
+  }
+
+  const long rssBefore = residentKb();
+  const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_GLOBAL);
+  const double loadMs = msSince(t0);
+  const long rssAfter = residentKb();
+  if (!handle) {
+    std::fprintf(stderr, "cannot load %s: %s\n", library.c_str(), dlerror());
+    return 1;
+  }
+
+  std::printf("library %s\n", library.c_str());
+  std::printf("load_ms %.3f\n", loadMs);
+  std::printf("rss_before_kb %ld\n", rssBefore);
+  std::printf("rss_after_kb %ld\n", rssAfter);
+  std::printf("rss_delta_kb %ld\n", rssAfter - rssBefore);
+
+  int missing = 0;
+  for (size_t i = 0; i < types.size(); ++i) {
+    const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    const bool found = edm::typelookup::findType(types[i].c_str()).first != 0;
+    std::printf("lookup_us %s %.3f%s\n", types[i].c_str(), 1000. * msSince(t1), found ? "" : " missing");
+    missing += !found;
+  }
+  return missing ? 2 : 0;
+}
@@ -0,0 +1,186 @@
+// Checks that readBinary(writeBinary(settings)) gives back every field of
+// EcalSRSettings bit for bit, with the per-region vectors in their 1, 2,
+// 54 and 75848 element modes, random or mostly constant contents and
+// special float values (-0, denormals, infinities, NaN). Also checks the
+// byte order of the floats, and that truncated inputs throw.
+//
+//   EcalSRSettingsBinaryTest [seed]
+//
+// Prints the number of failures and returns 1 if there is any.
+
+#include "CondFormats/EcalObjects/interface/EcalSRSettings.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  int failures = 0;
+
+  void check(bool ok, const std::string& what) {
+    if (!ok) {
+      if (failures < 10) std::printf("failed: %s\n", what.c_str());
+      ++failures;
+    }
+  }
+
+  // bit exact, so that NaN and -0 compare as written
+  template <typename T>
+  bool same(const T& a, const T& b) { return std::memcmp(&a, &b, sizeof(T)) == 0; }
+
+  template <typename T>
+  bool same(const std::vector<T>& a, const std::vector<T>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (!same(a[i], b[i])) return false;
+    }
+    return true;
+  }
+
+  bool same(const EcalSRSettings& a, const EcalSRSettings& b, const std::string& mode) {
+    const int before = failures;
+#define SR_CHECK(f) check(same(a.f ## _, b.f ## _), mode + ": " #f)
+    SR_CHECK(deltaEta);
+    SR_CHECK(deltaPhi);
+    SR_CHECK(ecalDccZs1stSample);
+    SR_CHECK(ebDccAdcToGeV);
+    SR_CHECK(eeDccAdcToGeV);
+    SR_CHECK(dccNormalizedWeights);
+    SR_CHECK(symetricZS);
+    SR_CHECK(srpLowInterestChannelZS);
+    SR_CHECK(srpHighInterestChannelZS);
+    SR_CHECK(actions);
+    SR_CHECK(tccMasksFromConfig);
+    SR_CHECK(srpMasksFromConfig);
+    SR_CHECK(dccMasks);
+    SR_CHECK(srfMasks);
+    SR_CHECK(substitutionSrfs);
+    SR_CHECK(testerTccEmuSrpIds);
+    SR_CHECK(testerSrpEmuSrpIds);
+    SR_CHECK(testerDccTestSrpIds);
+    SR_CHECK(testerSrpTestSrpIds);
+    SR_CHECK(bxOffsets);
+    SR_CHECK(bxGlobalOffset);
+    SR_CHECK(automaticMasks);
+    SR_CHECK(automaticSrpSelect);
+#undef SR_CHECK
+    return failures == before;
+  }
+
+  float randomFloat() {
+    switch (std::rand() % 16) {
+      case 0: return -0.f;
+      case 1: return std::numeric_limits<float>::denorm_min();
+      case 2: return std::numeric_limits<float>::infinity();
+      case 3: return -std::numeric_limits<float>::infinity();
+      case 4: return std::numeric_limits<float>::quiet_NaN();
+      default: return (std::rand() - RAND_MAX / 2) / 1000.f;
+    }
+  }
+
+  int randomInt() {
+    switch (std::rand() % 8) {
+      case 0: return std::numeric_limits<int>::min();
+      case 1: return std::numeric_limits<int>::max();
+      default: return std::rand() % 2000 - 1000;
+    }
+  }
+
+  short randomShort() { return short(std::rand() % 65536 - 32768); }
+
+  // n values, random or, if constant, runs of a few distinct values
+  template <typename T>
+  std::vector<T> values(size_t n, bool constant, T (*random)()) {
+    std::vector<T> v;
+    while (v.size() < n) {
+      const T x = random();
+      v.insert(v.end(), constant ? std::min(n - v.size(), size_t(1 + std::rand() % 20000)) : 1, x);
+    }
+    return v;
+  }
+
+  EcalSRSettings settings(size_t n, bool constant) {
+    EcalSRSettings s;
+    s.deltaEta_ = values(n, constant, randomInt);
+    s.deltaPhi_ = values(n, constant, randomInt);
+    s.ecalDccZs1stSample_ = values(n, constant, randomInt);
+    s.ebDccAdcToGeV_ = randomFloat();
+    s.eeDccAdcToGeV_ = randomFloat();
+    const std::vector<float> w = values(6, false, randomFloat);
+    for (size_t i = 0; i < n; ++i) s.dccNormalizedWeights_.push_back(constant ? w : values(6, false, randomFloat));
+    s.symetricZS_ = values(n, constant, randomInt);
+    s.srpLowInterestChannelZS_ = values(n, constant, randomFloat);
+    s.srpHighInterestChannelZS_ = values(n, constant, randomFloat);
+    s.actions_ = values(4, false, randomInt);
+    s.tccMasksFromConfig_ = values(EcalSRSettings::nTccs_, constant, randomShort);
+    s.dccMasks_ = values(EcalSRSettings::nDccs_, constant, randomShort);
+    s.srfMasks_ = values(EcalSRSettings::nSrps_, constant, randomShort);
+    for (int i = 0; i < EcalSRSettings::nSrps_; ++i) {
+      s.srpMasksFromConfig_.push_back(values(8, constant, randomShort));
+      s.substitutionSrfs_.push_back(values(68, constant, randomShort));
+    }
+    s.testerTccEmuSrpIds_ = values(EcalSRSettings::nSrps_, constant, randomInt);
+    s.testerSrpEmuSrpIds_ = values(EcalSRSettings::nSrps_, constant, randomInt);
+    s.testerDccTestSrpIds_ = values(EcalSRSettings::nSrps_, constant, randomInt);
+    s.testerSrpTestSrpIds_ = values(EcalSRSettings::nSrps_, constant, randomInt);
+    s.bxOffsets_ = values(EcalSRSettings::nSrps_, constant, randomShort);
+    s.bxGlobalOffset_ = randomShort();
+    s.automaticMasks_ = randomInt();
+    s.automaticSrpSelect_ = randomInt();
+    return s;
+  }
+
+  bool throws(const std::string& bytes) {
+    std::istringstream in(bytes);
+    EcalSRSettings s;
+    try {
+      readBinary(in, s);
+    } catch (cms::Exception&) {
+      return true;
+    }
+    return false;
+  }
+}
+
+int main(int argc, char** argv) {
+  std::srand(argc > 1 ? std::atoi(argv[1]) : 1);
+
+  const size_t modes[] = { 1, 2, 54, 75848 };
+  for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m) {
+    for (int constant = 0; constant < 2; ++constant) {
+      char mode[64];
+      std::snprintf(mode, sizeof(mode), "%zu elements%s", modes[m], constant ? ", constant" : "");
+      const EcalSRSettings written = settings(modes[m], constant);
+      std::ostringstream out;
+      writeBinary(out, written);
+      std::istringstream in(out.str());
+      EcalSRSettings read = settings(3, false);  // replaced by readBinary()
+      readBinary(in, read);
+      same(written, read, mode);
+      check(in.peek() == std::istringstream::traits_type::eof(), std::string(mode) + ": trailing bytes");
+      std::printf("%s: %zu bytes\n", mode, out.str().size());
+
+      // truncated anywhere in the first bytes, and by its last byte
+      const std::string bytes = out.str();
+      for (size_t k = 0; k < std::min(bytes.size(), size_t(64)); ++k) {
+        check(throws(bytes.substr(0, k)), std::string(mode) + ": truncated input accepted");
+      }
+      check(throws(bytes.substr(0, bytes.size() - 1)), std::string(mode) + ": truncated input accepted");
+    }
+  }
+
+  // floats little endian: 1.f (0x3f800000) right after the three empty vectors following the magic
+  EcalSRSettings one;
+  one.ebDccAdcToGeV_ = 1.f;
+  std::ostringstream out;
+  writeBinary(out, one);
+  check(out.str().compare(8 + 3, 4, std::string("\x00\x00\x80\x3f", 4)) == 0, "float byte order");
+
+  std::printf("failures %d\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+// Checks EcalSRZeroSuppressor against a scalar transcription of the
+// selective readout emulator (EcalSelectiveReadoutSuppressor::accept() in
+// SimCalorimetry/EcalSelectiveReadoutAlgos), frame by frame, on random
+// settings and frames: gain switches, negative FIR outputs, symmetric ZS,
+// windows beyond the frame and the INT_MIN and INT_MAX thresholds.
+//
+//   EcalSRZeroSuppressorTest [seed]
+//
+// Prints the number of mismatches and returns 1 if there is any.
+
+#include "CondFormats/EcalObjects/interface/EcalSRZeroSuppressor.h"
+#include "DataFormats/EcalDetId/interface/EcalElectronicsId.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+  // EcalSelectiveReadoutSuppressor::accept(), with the FIR settings of one crystal
+  class SelectiveReadoutSuppressor {
+   public:
+    SelectiveReadoutSuppressor(const int32_t* firWeights, int firstFIRSample, bool symetricZS)
+      : firWeights_(firWeights), firstFIRSample_(firstFIRSample), symetricZS_(symetricZS) {}
+
+    bool accept(const uint16_t* frame, int frameSize, int thr) const {
+      int acc = 0;
+      bool gain12saturated = false;
+      const int gain12 = 0x01;
+      const int lastFIRSample = firstFIRSample_ + nFIRTaps - 1;
+      int iWeight = 0;
+      for (int iSample = firstFIRSample_ - 1; iSample < lastFIRSample; ++iSample, ++iWeight) {
+        if (iSample >= 0 && iSample < frameSize) {
+          const int gainId = (frame[iSample] >> 12) & 0x3;
+          const int adc = frame[iSample] & 0xfff;
+          if (gainId != gain12) gain12saturated = true;
+          acc += adc * firWeights_[iWeight];
+        }
+      }
+      if (symetricZS_ && acc < 0) acc = -acc;
+      // discards the 8 LSBs, offset to a positive value before the shift
+      acc = ((acc + (1 << 30)) >> 8) - (1 << 22);
+      return acc >= thr || gain12saturated;
+    }
+
+   private:
+    static const int nFIRTaps = EcalSRSettingsTable::kNWeights;
+    const int32_t* firWeights_;
+    int firstFIRSample_;
+    bool symetricZS_;
+  };
+
+  float uniform(float lo, float hi) { return lo + (hi - lo) * (std::rand() / (RAND_MAX + 1.f)); }
+}
+
+int main(int argc, char** argv) {
+  std::srand(argc > 1 ? std::atoi(argv[1]) : 1);
+  const unsigned int nSamples = 10;
+  const int nDccs = 54;
+
+  // per DCC settings, thresholds from always to never (but gain switches) kept
+  EcalSRSettings settings;
+  settings.ebDccAdcToGeV_ = 0.035;
+  settings.eeDccAdcToGeV_ = 0.06;
+  for (int dcc = 0; dcc < nDccs; ++dcc) {
+    settings.ecalDccZs1stSample_.push_back(1 + std::rand() % 8);
+    std::vector<float> w(EcalSRSettingsTable::kNWeights);
+    for (size_t k = 0; k < w.size(); ++k) w[k] = uniform(-1.5f, 1.5f);
+    settings.dccNormalizedWeights_.push_back(w);
+    settings.symetricZS_.push_back(std::rand() % 2);
+    settings.srpLowInterestChannelZS_.push_back(dcc % 9 == 0 ? 1e9f : dcc % 9 == 1 ? -1e9f : uniform(-2.f, 2.f));
+    settings.srpHighInterestChannelZS_.push_back(dcc % 7 == 0 ? 1e9f : dcc % 7 == 1 ? -1e9f : uniform(-2.f, 2.f));
+  }
+  EcalMappingElectronics mapping;
+  for (uint32_t d = 0; d < EcalDenseIndex::kSizeForDenseIndexing; ++d) {
+    const EcalMappingElement m = { EcalElectronicsId(1 + d % nDccs, 1, 1, 1).rawId(), 0 };
+    mapping.setValue(EcalDenseIndex::toRawId(d), m);
+  }
+  const EcalSRSettingsTable table(settings, mapping);
+  const EcalSRZeroSuppressor zs(table);
+
+  // random crystals, pedestal-like samples with pulses, dips and gain switches
+  const size_t n = 100003;
+  std::vector<uint32_t> crystals(n);
+  std::vector<uint8_t> highInterest(n);
+  std::vector<uint16_t> samples(n * nSamples);
+  for (size_t i = 0; i < n; ++i) {
+    crystals[i] = std::rand() % EcalDenseIndex::kSizeForDenseIndexing;
+    highInterest[i] = std::rand() % 4 == 0;
+    for (unsigned int s = 0; s < nSamples; ++s) {
+      const int gain = std::rand() % 40 == 0 ? 2 + std::rand() % 2 : 1;
+      const int adc = 200 + std::rand() % 40 - (std::rand() % 20 == 0 ? 150 : 0) + (s == 5 ? std::rand() % 400 : 0);
+      samples[i * nSamples + s] = uint16_t(gain << 12 | adc);
+    }
+  }
+
+  std::vector<uint64_t> keep((n + 63) / 64);
+  zs.run(n, nSamples, &crystals[0], &samples[0], &highInterest[0], &keep[0]);
+
+  size_t mismatches = 0, kept = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t d = crystals[i];
+    const SelectiveReadoutSuppressor reference(table.weights(table.weightSet(d)), table.firstSample(d) + 1,
+                                               table.symmetric(d));
+    const int thr = highInterest[i] ? table.thresholdHigh(d) : table.thresholdLow(d);
+    const bool expected = reference.accept(&samples[i * nSamples], nSamples, thr);
+    const bool batch = (keep[i >> 6] >> (i & 63)) & 1;
+    const bool single = zs.accept(d, &samples[i * nSamples], nSamples, highInterest[i] != 0);
+    kept += expected;
+    if (batch != expected || single != expected) {
+      if (mismatches < 10) {
+        std::printf("frame %zu crystal %u threshold %d: %d and %d, expected %d\n", i, d, thr, batch, single, expected);
+      }
+      ++mismatches;
+    }
+  }
+  std::printf("frames %zu kept %zu mismatches %zu\n", n, kept, mismatches);
+  return mismatches ? 1 : 0;
+}
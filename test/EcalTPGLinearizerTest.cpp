@@ -0,0 +1,113 @@
+// Checks EcalTPGLinearizer against a scalar transcription of the TPG
+// emulator linearizer (EcalFenixLinearizer in SimCalorimetry/
+// EcalTrigPrimAlgos), sample by sample, on random constants and frames of
+// all the gains, saturated samples included.
+//
+//   EcalTPGLinearizerTest [seed]
+//
+// Prints the number of mismatches and returns 1 if there is any.
+
+#include "CondFormats/EcalObjects/interface/EcalTPGLinearizer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+  // EcalFenixLinearizer::setInput() and process(), for one sample
+  class FenixLinearizer {
+   public:
+    FenixLinearizer(const EcalTPGPedestal& peds, const EcalTPGLinearizationConstant& linConsts)
+      : peds_(peds), linConsts_(linConsts) {}
+
+    int process(uint16_t raw) {
+      uncorrectedSample_ = raw & 0xfff;
+      gainID_ = (raw >> 12) & 0x3;
+      if (gainID_ == 0) {
+        base_ = 0;
+        shift_ = linConsts_.shift_x1;
+        mult_ = 0xFF;
+      } else if (gainID_ == 1) {
+        base_ = peds_.mean_x12;
+        shift_ = linConsts_.shift_x12;
+        mult_ = linConsts_.mult_x12;
+      } else if (gainID_ == 2) {
+        base_ = peds_.mean_x6;
+        shift_ = linConsts_.shift_x6;
+        mult_ = linConsts_.mult_x6;
+      } else {
+        base_ = peds_.mean_x1;
+        shift_ = linConsts_.shift_x1;
+        mult_ = linConsts_.mult_x1;
+      }
+
+      int output = uncorrectedSample_ - base_;
+      if (output < 0) return 0;
+      output = (output * mult_) >> (shift_ + 2);
+      if (output > 0x3FFFF) output = 0x3FFFF;
+      return output;
+    }
+
+   private:
+    const EcalTPGPedestal& peds_;
+    const EcalTPGLinearizationConstant& linConsts_;
+    int uncorrectedSample_;
+    int gainID_;
+    int base_;
+    int shift_;
+    int mult_;
+  };
+}
+
+int main(int argc, char** argv) {
+  std::srand(argc > 1 ? std::atoi(argv[1]) : 1);
+  const size_t n = EcalDenseIndex::kSizeForDenseIndexing;
+  const unsigned int nSamples = 10;
+
+  std::vector<EcalTPGPedestal> peds(n);
+  std::vector<EcalTPGLinearizationConstant> lin(n);
+  for (size_t i = 0; i < n; ++i) {
+    peds[i].mean_x12 = 150 + std::rand() % 100;
+    peds[i].mean_x6 = 150 + std::rand() % 100;
+    peds[i].mean_x1 = 150 + std::rand() % 100;
+    lin[i].mult_x12 = std::rand() % 256;
+    lin[i].mult_x6 = std::rand() % 256;
+    lin[i].mult_x1 = std::rand() % 256;
+    lin[i].shift_x12 = std::rand() % 8;
+    lin[i].shift_x6 = std::rand() % 8;
+    lin[i].shift_x1 = std::rand() % 8;
+  }
+  EcalTPGPedestals pedestals;
+  EcalTPGLinearizationConst linearization;
+  pedestals.fill(&peds[0], n);
+  linearization.fill(&lin[0], n);
+  const EcalTPGLinearizer linearizer(pedestals, linearization);
+
+  // every crystal once, in a shuffled order, with random samples of any gain
+  std::vector<uint32_t> crystals(n);
+  for (size_t i = 0; i < n; ++i) crystals[i] = i;
+  for (size_t i = n - 1; i > 0; --i) std::swap(crystals[i], crystals[std::rand() % (i + 1)]);
+  std::vector<uint16_t> samples(n * nSamples);
+  for (size_t i = 0; i < samples.size(); ++i) samples[i] = uint16_t((std::rand() % 4) << 12 | std::rand() % 4096);
+
+  std::vector<int32_t> out(samples.size());
+  linearizer.linearize(n, nSamples, &crystals[0], &samples[0], &out[0]);
+
+  size_t mismatches = 0;
+  for (size_t f = 0; f < n; ++f) {
+    FenixLinearizer fenix(peds[crystals[f]], lin[crystals[f]]);
+    for (unsigned int s = 0; s < nSamples; ++s) {
+      const size_t i = f * nSamples + s;
+      const int expected = fenix.process(samples[i]);
+      if (out[i] != expected || linearizer.linearize(crystals[f], samples[i]) != expected) {
+        if (mismatches < 10) {
+          std::printf("crystal %u sample 0x%04x: %d and %d, expected %d\n", crystals[f], samples[i], out[i],
+                      linearizer.linearize(crystals[f], samples[i]), expected);
+        }
+        ++mismatches;
+      }
+    }
+  }
+  std::printf("samples %zu mismatches %zu\n", samples.size(), mismatches);
+  return mismatches ? 1 : 0;
+}